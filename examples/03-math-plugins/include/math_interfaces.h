@@ -21,6 +21,7 @@
  * standard floating-point edge cases.
  */
 class IMathOperation : public fourdst::plugin::PluginBase {
+    FOURDST_DECLARE_INTERFACE(IMathOperation, fourdst::plugin::PluginBase, "fourdst.examples.IMathOperation/1");
 public:
     using PluginBase::PluginBase;
     /**
@@ -68,6 +69,7 @@ public:
  * logarithmic, exponential, and other transcendental functions.
  */
 class IAdvancedMath : public fourdst::plugin::PluginBase {
+    FOURDST_DECLARE_INTERFACE(IAdvancedMath, fourdst::plugin::PluginBase, "fourdst.examples.IAdvancedMath/1");
 public:
     using PluginBase::PluginBase;
     /**
@@ -203,6 +203,7 @@ struct DataSeries {
  * Useful for point-wise operations like scaling, unit conversion, etc.
  */
 class IDataPointProcessor : public fourdst::plugin::templates::FunctorPlugin_T<DataPoint> {
+    FOURDST_DECLARE_INTERFACE(IDataPointProcessor, fourdst::plugin::templates::FunctorPlugin_T<DataPoint>, "fourdst.examples.IDataPointProcessor/1");
 public:
     /**
      * @brief Virtual destructor
@@ -219,6 +220,7 @@ public:
  * data points together (e.g., filtering, smoothing, trend analysis).
  */
 class IDataSeriesProcessor : public fourdst::plugin::templates::FunctorPlugin_T<DataSeries> {
+    FOURDST_DECLARE_INTERFACE(IDataSeriesProcessor, fourdst::plugin::templates::FunctorPlugin_T<DataSeries>, "fourdst.examples.IDataSeriesProcessor/1");
 public:
     using FunctorPlugin_T<DataSeries>::FunctorPlugin_T;
     /**
@@ -17,11 +17,14 @@
  * is configurable.
  */
 class MovingAverage final : public IDataSeriesProcessor {
+    FOURDST_DECLARE_CONCURRENCY(Pure);
+
 private:
     size_t m_window_size = 5; ///< Size of the moving average window
     
 public:
     using IDataSeriesProcessor::IDataSeriesProcessor;
+    using IDataSeriesProcessor::operator();
     /**
      * @brief Apply moving average smoothing to a data series
      * 
@@ -29,24 +32,35 @@ public:
      * @return DataSeries The smoothed data series
      */
     DataSeries operator()(const DataSeries& input) const override {
-        if (input.empty() || input.size() < m_window_size) {
-            // Return unchanged if too few points
-            DataSeries result = input;
-            result.add_processing_step("moving_average", "skipped (insufficient data)");
-            return result;
+        DataSeries result = input;
+        transform(result);
+        return result;
+    }
+    
+    /**
+     * @brief Smooth a data series in place
+     * 
+     * @param series The data series to smooth
+     */
+    void transform(DataSeries& series) const override {
+        if (series.empty() || series.size() < m_window_size) {
+            // Leave unchanged if too few points
+            series.add_processing_step("moving_average", "skipped (insufficient data)");
+            return;
         }
         
-        std::vector<DataPoint> smoothed_points;
-        smoothed_points.reserve(input.points.size());
+        // Windows overlap, so the averages are computed from the original values first
+        std::vector<double> averaged(series.points.size());
+        std::vector<size_t> counts(series.points.size());
         
         // Apply moving average
-        for (size_t i = 0; i < input.points.size(); ++i) {
+        for (size_t i = 0; i < series.points.size(); ++i) {
             // Determine window boundaries
             size_t start = (i >= m_window_size / 2) ? i - m_window_size / 2 : 0;
-            size_t end = std::min(start + m_window_size, input.points.size());
+            size_t end = std::min(start + m_window_size, series.points.size());
             
             // Adjust start if we're near the end
-            if (end - start < m_window_size && end == input.points.size()) {
+            if (end - start < m_window_size && end == series.points.size()) {
                 start = (end >= m_window_size) ? end - m_window_size : 0;
             }
             
@@ -55,33 +69,28 @@ public:
             size_t count = 0;
             
             for (size_t j = start; j < end; ++j) {
-                sum += input.points[j].value;
+                sum += series.points[j].value;
                 count++;
             }
             
-            double averaged_value = sum / static_cast<double>(count);
-            
-            // Create smoothed point with original timestamp and metadata
-            DataPoint smoothed_point = input.points[i];
-            smoothed_point.value = averaged_value;
+            averaged[i] = sum / static_cast<double>(count);
+            counts[i] = count;
+        }
+        
+        // Keep timestamps and metadata, replace the values
+        for (size_t i = 0; i < series.points.size(); ++i) {
+            DataPoint& point = series.points[i];
+            point.value = averaged[i];
             
             // Add metadata about the smoothing
-            smoothed_point.metadata["smoothed"] = "true";
-            smoothed_point.metadata["window_size"] = std::to_string(count);
-            
-            smoothed_points.push_back(smoothed_point);
+            point.metadata["smoothed"] = "true";
+            point.metadata["window_size"] = std::to_string(counts[i]);
         }
         
-        // Create result series
-        DataSeries result(std::move(smoothed_points), input.source, input.description);
-        result.processing_history = input.processing_history;
-        
         // Add processing metadata
         std::ostringstream info;
         info << "applied " << m_window_size << "-point moving average";
-        result.add_processing_step("moving_average", info.str());
-        
-        return result;
+        series.add_processing_step("moving_average", info.str());
     }
     
     /**
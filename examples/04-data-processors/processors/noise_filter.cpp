@@ -18,68 +18,64 @@
  * statistical outliers. The threshold is configurable via metadata.
  */
 class NoiseFilter : public IDataSeriesProcessor {
+    FOURDST_DECLARE_CONCURRENCY(Pure);
+
 private:
     double m_threshold = 2.0; ///< Z-score threshold for outlier detection
     
 public:
     using IDataSeriesProcessor::IDataSeriesProcessor;
+    using IDataSeriesProcessor::operator();
     /**
      * @brief Apply noise filtering to a data series
      * 
      * @param input The input data series
      * @return DataSeries The filtered data series with outliers removed
-     * 
-     * @throw std::runtime_error If the input series is too small for statistical analysis
      */
     DataSeries operator()(const DataSeries& input) const override {
-        if (input.empty()) {
-            return input; // Return empty series unchanged
+        DataSeries result = input;
+        transform(result);
+        return result;
+    }
+    
+    /**
+     * @brief Remove outliers from a data series in place
+     * 
+     * @param series The data series to filter
+     */
+    void transform(DataSeries& series) const override {
+        if (series.empty()) {
+            return; // Leave empty series unchanged
         }
         
-        if (input.size() < 3) {
+        if (series.size() < 3) {
             // Too few points for meaningful outlier detection
-            DataSeries result = input;
-            result.add_processing_step("noise_filter", "skipped (insufficient data)");
-            return result;
+            series.add_processing_step("noise_filter", "skipped (insufficient data)");
+            return;
         }
         
         // Calculate mean and standard deviation
-        double mean = input.mean_value();
-        double std_dev = input.std_deviation();
+        double mean = series.mean_value();
+        double std_dev = series.std_deviation();
         
         if (std::isnan(std_dev) || std_dev == 0.0) {
             // No variation in data
-            DataSeries result = input;
-            result.add_processing_step("noise_filter", "skipped (no variation)");
-            return result;
-        }
-        
-        // Filter outliers based on Z-score
-        std::vector<DataPoint> filtered_points;
-        size_t removed_count = 0;
-        
-        for (const auto& point : input.points) {
-            double z_score = std::abs(point.value - mean) / std_dev;
-            
-            if (z_score <= m_threshold) {
-                filtered_points.push_back(point);
-            } else {
-                removed_count++;
-            }
+            series.add_processing_step("noise_filter", "skipped (no variation)");
+            return;
         }
         
-        // Create result series
-        DataSeries result(std::move(filtered_points), input.source, input.description);
-        result.processing_history = input.processing_history;
+        // Filter outliers based on Z-score; kept points are moved, not copied
+        const size_t original_size = series.size();
+        const size_t removed_count = std::erase_if(series.points, [&](const DataPoint& point) {
+            return std::abs(point.value - mean) / std_dev > m_threshold;
+        });
         
         // Add processing metadata
         std::ostringstream info;
         info << "removed " << removed_count << " outliers (threshold=" << m_threshold 
              << ", " << std::fixed << std::setprecision(1) 
-             << (100.0 * removed_count / input.size()) << "%)";
-        result.add_processing_step("noise_filter", info.str());
-        
-        return result;
+             << (100.0 * removed_count / original_size) << "%)";
+        series.add_processing_step("noise_filter", info.str());
     }
     
     /**
@@ -17,11 +17,14 @@
  * or amplification.
  */
 class ScaleTransform : public IDataSeriesProcessor {
+    FOURDST_DECLARE_CONCURRENCY(Pure);
+
 private:
     double m_scale_factor = 1.0; ///< The scaling factor to apply
     
 public:
     using IDataSeriesProcessor::IDataSeriesProcessor;
+    using IDataSeriesProcessor::operator();
     /**
      * @brief Apply scaling transformation to a data series
      * 
@@ -29,35 +32,36 @@ public:
      * @return DataSeries The scaled data series
      */
     DataSeries operator()(const DataSeries& input) const override {
-        if (input.empty()) {
-            return input; // Return empty series unchanged
+        DataSeries result = input;
+        transform(result);
+        return result;
+    }
+    
+    /**
+     * @brief Scale a data series in place
+     * 
+     * @param series The data series to scale
+     */
+    void transform(DataSeries& series) const override {
+        if (series.empty()) {
+            return; // Leave empty series unchanged
         }
         
-        std::vector<DataPoint> scaled_points;
-        scaled_points.reserve(input.points.size());
+        const std::string factor = std::to_string(m_scale_factor);
         
         // Scale each data point
-        for (const auto& point : input.points) {
-            DataPoint scaled_point = point;
-            scaled_point.value *= m_scale_factor;
+        for (auto& point : series.points) {
+            point.value *= m_scale_factor;
             
             // Add metadata about the scaling
-            scaled_point.metadata["scaled"] = "true";
-            scaled_point.metadata["scale_factor"] = std::to_string(m_scale_factor);
-            
-            scaled_points.push_back(scaled_point);
+            point.metadata["scaled"] = "true";
+            point.metadata["scale_factor"] = factor;
         }
         
-        // Create result series
-        DataSeries result(std::move(scaled_points), input.source, input.description);
-        result.processing_history = input.processing_history;
-        
         // Add processing metadata
         std::ostringstream info;
         info << "scaled by factor " << m_scale_factor;
-        result.add_processing_step("scale_transform", info.str());
-        
-        return result;
+        series.add_processing_step("scale_transform", info.str());
     }
     
     /**
@@ -17,6 +17,7 @@
 
 #include "fourdst/plugin/manager/plugin_manager.h"
 #include "fourdst/plugin/exception/exceptions.h"
+#include "fourdst/plugin/pipeline/pipeline.h"
 #include "../include/data_interfaces.h"
 
 /**
@@ -101,7 +102,7 @@ void print_series_stats(const DataSeries& series, const std::string& prefix = ""
 class DataPipeline {
 private:
     fourdst::plugin::manager::PluginManager& m_manager = fourdst::plugin::manager::PluginManager::getInstance();
-    std::vector<IDataSeriesProcessor*> m_processors;
+    fourdst::plugin::pipeline::Pipeline<DataSeries> m_pipeline;
     
 public:
     /**
@@ -119,7 +120,7 @@ public:
             // Try to get as data series processor
             try {
                 auto* processor = m_manager.get<IDataSeriesProcessor>(plugin_path.stem().string());
-                m_processors.push_back(processor);
+                m_pipeline.add(*processor);
                 std::cout << " ✓ (DataSeries processor)\n";
                 return true;
             } catch (const fourdst::plugin::exception::PluginTypeError&) {
@@ -144,23 +145,20 @@ public:
      * @return DataSeries The processed data series
      */
     DataSeries process_data(const DataSeries& input_data) {
-        DataSeries current_data = input_data;
+        // The pipeline copies the input once, then every stage works on it in place
+        const DataSeries& result = m_pipeline.run(input_data);
         
         std::cout << "\nProcessing pipeline:\n";
-        for (size_t i = 0; i < m_processors.size(); ++i) {
-            auto* processor = m_processors[i];
+        const auto timings = m_pipeline.timings();
+        for (size_t i = 0; i < timings.size(); ++i) {
+            // The pipeline keeps a latency histogram per stage across runs; report the median
+            auto duration = std::chrono::duration_cast<std::chrono::microseconds>(timings[i].latency.percentile(50));
             
-            auto start_time = std::chrono::high_resolution_clock::now();
-            current_data = (*processor)(current_data);
-            auto end_time = std::chrono::high_resolution_clock::now();
-            
-            auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
-            
-            std::cout << "  " << (i + 1) << ". " << processor->get_name() 
+            std::cout << "  " << (i + 1) << ". " << timings[i].name 
                       << " (" << duration.count() << "μs)\n";
         }
         
-        return current_data;
+        return result;
     }
     
     /**
@@ -169,23 +167,23 @@ public:
      * @return size_t Number of processors
      */
     size_t get_processor_count() const {
-        return m_processors.size();
+        return m_pipeline.size();
     }
     
     /**
      * @brief List loaded processors
      */
     void list_processors() {
-        if (m_processors.empty()) {
+        if (m_pipeline.size() == 0) {
             std::cout << "No processors loaded.\n";
             return;
         }
         
         std::cout << "Loaded processors:\n";
-        for (size_t i = 0; i < m_processors.size(); ++i) {
-            auto* processor = m_processors[i];
-            std::cout << "  " << (i + 1) << ". " << processor->get_name() 
-                      << " v" << processor->get_version() << "\n";
+        for (size_t i = 0; i < m_pipeline.size(); ++i) {
+            const auto& processor = m_pipeline.stage(i);
+            std::cout << "  " << (i + 1) << ". " << processor.get_name() 
+                      << " v" << processor.get_version() << "\n";
         }
     }
 };
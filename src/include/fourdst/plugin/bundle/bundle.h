@@ -12,6 +12,7 @@
 #include "fourdst/plugin/manager/plugin_manager.h"
 #include "fourdst/plugin/bundle/utils.h"
 
+#include <chrono>
 #include <string>
 #include <filesystem>
 #include <vector>
@@ -55,6 +56,30 @@ namespace fourdst::plugin::bundle {
         ANY_PLUGINS_ABI_COMPATIBLE = 1   ///< Load any plugins that are ABI compatible
     };
 
+    /**
+     * @brief Time spent in each phase of opening a bundle.
+     *
+     * Phases that were not reached or do not apply (e.g. signature checks of an
+     * unsigned bundle) are zero. Per-plugin figures for the load phase are
+     * recorded by the manager when its load statistics are enabled.
+     */
+    struct BundleLoadStats {
+        std::filesystem::path path;             ///< The bundle file
+        std::chrono::nanoseconds unzip{0};      ///< Extracting the archive
+        std::chrono::nanoseconds manifest{0};   ///< Reading and walking the manifest
+        std::chrono::nanoseconds checksum{0};   ///< Hashing the bundled files
+        std::chrono::nanoseconds signature{0};  ///< Finding the trusted key and verifying the signature
+        std::chrono::nanoseconds abi_filter{0}; ///< Selecting the binaries compatible with the host
+        std::chrono::nanoseconds load{0};       ///< Loading the selected plugins into the manager
+        std::chrono::nanoseconds total{0};      ///< Wall time of the whole construction
+        std::vector<std::string> plugins;       ///< Plugins that were loaded
+    };
+
+    /**
+     * @brief Serialize bundle load statistics as a JSON object, durations in nanoseconds.
+     */
+    [[nodiscard]] std::string to_json(const BundleLoadStats& stats);
+
     /**
      * @brief Manages a bundle of plugins.
      * 
@@ -127,6 +152,16 @@ namespace fourdst::plugin::bundle {
          * @param[in] policy Load policy for ABI compatibility checks.
          */
         explicit PluginBundle(const std::filesystem::path& filename, PluginLoadPolicy policy);
+
+        /**
+         * @brief Construct a new PluginBundle that loads its plugins into the given manager.
+         * 
+         * @param[in] filename Path to the bundle file.
+         * @param[in] manager Manager the bundle's plugins are loaded into; must outlive the bundle.
+         * @param[in] policy Load policy for ABI compatibility checks.
+         */
+        explicit PluginBundle(const std::filesystem::path& filename, manager::PluginManager& manager,
+                              PluginLoadPolicy policy = PluginLoadPolicy::ALL_PLUGINS_ABI_COMPATIBLE);
         
         ~PluginBundle() = default;
 
@@ -210,10 +245,17 @@ namespace fourdst::plugin::bundle {
          */
         bool isBundleSigned() const;
 
+        /**
+         * @brief Get the time spent in each phase of opening the bundle.
+         * 
+         * @return const BundleLoadStats& Timings recorded by the constructor.
+         */
+        const BundleLoadStats& getLoadStats() const;
+
     private:
         std::filesystem::path m_filepath;                   ///< Path to the bundle file
         PluginLoadPolicy m_loadPolicy;  ///< Current load policy
-        manager::PluginManager& m_pluginManager;            ///< Reference to the plugin manager
+        manager::PluginManager& m_pluginManager;            ///< Manager the plugins are loaded into (the default one unless given)
 
         std::string m_hostABISignature;     ///< ABI signature of the host system
         std::string m_hostArchitecture;     ///< Architecture of the host system
@@ -238,6 +280,8 @@ namespace fourdst::plugin::bundle {
 
         utils::TemporaryDirectory m_temporaryDirectory;  ///< Temporary directory for bundle extraction
 
+        BundleLoadStats m_loadStats;    ///< Phase timings recorded while opening the bundle
+
     private:
         /**
          * @brief Load plugins from the specified platforms.
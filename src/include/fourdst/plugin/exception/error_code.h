@@ -0,0 +1,74 @@
+/**
+ * @file error_code.h
+ * @brief Error codes reported by the no-throw PluginManager API
+ *
+ * PluginManager::try_get, try_load and try_unload report failures as a
+ * PluginErrorCode instead of throwing. Each code corresponds to one of the
+ * exceptions in exceptions.h; the descriptive message those exceptions carry
+ * is only built when message() is called.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace fourdst::plugin::exception {
+
+    /**
+     * @brief Why a no-throw PluginManager call failed
+     */
+    enum class PluginErrorCode : std::uint8_t {
+        NotLoaded,         ///< No plugin with the name is loaded or registered (PluginNotLoadedError)
+        TypeMismatch,      ///< The plugin does not implement the requested interface (PluginTypeError)
+        LoadFailed,        ///< The library could not be opened, or its plugin could not be created (PluginLoadError)
+        MissingSymbol,     ///< The library lacks create_plugin or destroy_plugin (PluginSymbolError)
+        NameCollision,     ///< A plugin with the same name is already loaded (PluginNameCollisionError)
+        ResourceExhausted, ///< Memory or threads ran out (std::bad_alloc, std::system_error)
+    };
+
+    /**
+     * @brief Short, static description of an error code
+     *
+     * @throw Never throws
+     */
+    [[nodiscard]] constexpr std::string_view to_string(const PluginErrorCode code) noexcept {
+        switch (code) {
+            case PluginErrorCode::NotLoaded: return "plugin not loaded";
+            case PluginErrorCode::TypeMismatch: return "plugin type mismatch";
+            case PluginErrorCode::LoadFailed: return "plugin load failed";
+            case PluginErrorCode::MissingSymbol: return "plugin symbol missing";
+            case PluginErrorCode::NameCollision: return "plugin name collision";
+            case PluginErrorCode::ResourceExhausted: return "resources exhausted";
+        }
+        return "unknown plugin error";
+    }
+
+    /**
+     * @brief Build the descriptive message for an error code
+     *
+     * @param code The error reported by the no-throw call
+     * @param subject The plugin name (try_get, try_unload) or library path (try_load) passed to the call
+     * @return std::string A message in the style of the corresponding exception's what()
+     */
+    [[nodiscard]] inline std::string message(const PluginErrorCode code, const std::string_view subject) {
+        std::string text(subject);
+        switch (code) {
+            case PluginErrorCode::NotLoaded:
+                return text + " has not been loaded or does not exist (have you called manager.load()?)";
+            case PluginErrorCode::TypeMismatch:
+                return "Plugin " + text + " is not of the requested type";
+            case PluginErrorCode::LoadFailed:
+                return "Failed to load plugin library '" + text + "' (call load() for the loader's message)";
+            case PluginErrorCode::MissingSymbol:
+                return "Could not find 'create_plugin' or 'destroy_plugin' in library '" + text + "'.";
+            case PluginErrorCode::NameCollision:
+                return "The plugin in '" + text + "' has the name of an already loaded plugin.";
+            case PluginErrorCode::ResourceExhausted:
+                return "Ran out of resources while handling '" + text + "'.";
+        }
+        return std::string(to_string(code)) + ": " + text;
+    }
+
+}
@@ -9,7 +9,11 @@
 
 #pragma once
 
+#include <array>
+#include <cstddef>
+
 #include "fourdst/plugin/iplugin.h"
+#include "fourdst/plugin/inspect/plugin_note.h"
 
 #if defined(__GNUC__) || defined(__clang__)
     /**
@@ -26,6 +30,24 @@
     #define FOURDST_PLUGIN_EXPORT extern "C"
 #endif
 
+#if defined(__ELF__) && (defined(__GNUC__) || defined(__clang__))
+    /**
+     * @brief Embed the plugin's metadata note (see plugin_note.h) in the library
+     *
+     * The note is a compile-time constant placed in its own ELF section, so it can
+     * be read by fourdst::plugin::inspect without loading the library.
+     */
+    #define FOURDST_PLUGIN_NOTE(className, pluginName, pluginVersion)                                \
+        __attribute__((section(".note.fourdst.plugin"), used, aligned(4)))                          \
+        static constexpr auto fourdst_plugin_note = fourdst::plugin::note::make_plugin_note(     \
+            pluginName, pluginVersion, className::fourdst_interface_ids);
+#else
+    /**
+     * @brief Metadata notes are only emitted for ELF targets
+     */
+    #define FOURDST_PLUGIN_NOTE(className, pluginName, pluginVersion)
+#endif
+
 namespace fourdst::plugin {
 
     /**
@@ -70,8 +92,37 @@ namespace fourdst::plugin {
     class PluginBase : public IPluginBase {
     public:
         using IPluginBase::IPluginBase; // Inherit constructor for plugin name and version
+
+        /**
+         * @brief IDs of the interfaces declared along this class hierarchy
+         *
+         * Empty for PluginBase; every FOURDST_DECLARE_INTERFACE appends its own ID.
+         */
+        static constexpr std::array<interface_id_t, 0> fourdst_interface_ids{};
+
+        /**
+         * @brief Concurrency trait of this class hierarchy; FOURDST_DECLARE_CONCURRENCY replaces it
+         */
+        static constexpr Concurrency fourdst_concurrency = Concurrency::Serialized;
     };
 
+    /**
+     * @brief Append an interface ID to the ID list inherited from a base interface
+     *
+     * @param base_ids The interface IDs declared by the base class hierarchy
+     * @param id The interface ID to append
+     * @return std::array<interface_id_t, N + 1> The extended list
+     */
+    template<std::size_t N>
+    constexpr std::array<interface_id_t, N + 1> append_interface_id(const std::array<interface_id_t, N>& base_ids, const interface_id_t id) noexcept {
+        std::array<interface_id_t, N + 1> ids{};
+        for (std::size_t i = 0; i < N; ++i) {
+            ids[i] = base_ids[i];
+        }
+        ids[N] = id;
+        return ids;
+    }
+
     /**
      * @brief Function pointer type for plugin creation functions
      * 
@@ -92,6 +143,58 @@ namespace fourdst::plugin {
      */
     typedef void (*plugin_destroyer_t)(IPlugin*);
 
+    /**
+     * @brief Function pointer type for plugin interface enumeration functions
+     * 
+     * This type defines the signature for the optional function that a plugin
+     * library may export as "get_plugin_interfaces". It reports the interface IDs
+     * (see FOURDST_DECLARE_INTERFACE) implemented by the plugin class so that the
+     * manager can index the plugin by interface when it is loaded.
+     * 
+     * @param count Receives the number of IDs in the returned array
+     * @return const interface_id_t* Pointer to a static array of interface IDs
+     */
+    typedef const interface_id_t* (*plugin_interfaces_t)(std::size_t* count);
+
+    /**
+     * @brief Function pointer type for plugin function table lookup functions
+     * 
+     * This type defines the signature for the optional function that a plugin
+     * library may export as "get_plugin_function_table" (see
+     * FOURDST_DECLARE_FUNCTION_TABLES).
+     * 
+     * @param id The table_id of the requested FunctionTable
+     * @param size Receives sizeof the plugin's table, so hosts can detect older layouts
+     * @return const void* The plugin's table, or nullptr if it offers none with that ID
+     */
+    typedef const void* (*plugin_function_table_t)(interface_id_t id, std::size_t* size);
+
+    /**
+     * @brief Find the table with the given ID among a plugin's function tables
+     *
+     * Backend of FOURDST_DECLARE_FUNCTION_TABLES.
+     *
+     * @return const void* The matching table, or nullptr if none matches
+     */
+    template<FunctionTable... Tables>
+    const void* find_function_table(const interface_id_t id, std::size_t* size, const Tables&... tables) noexcept {
+        const void* found = nullptr;
+        (void)((id == Tables::table_id ? (found = &tables, *size = sizeof(Tables), true) : false) || ...);
+        return found;
+    }
+
+    /**
+     * @brief Function pointer type for plugin warm-up functions
+     * 
+     * This type defines the signature for the optional function that a plugin
+     * library may export as "warmup_plugin" (see FOURDST_DECLARE_PLUGIN_WARMUP).
+     * The manager calls it on a background thread once the plugin is loaded, so
+     * that caches, tables and JIT state are ready before the first real call.
+     * 
+     * @param IPlugin* The plugin instance created by create_plugin
+     */
+    typedef void (*plugin_warmup_t)(IPlugin*);
+
 }
 
 /**
@@ -102,6 +205,10 @@ namespace fourdst::plugin {
  * - Global variables for plugin name and version
  * - create_plugin() function that instantiates the plugin class
  * - destroy_plugin() function that safely deletes the plugin instance
+ * - get_plugin_interfaces() function that lists the interface IDs declared
+ *   along the plugin class hierarchy
+ * - A ".note.fourdst.plugin" ELF note recording the name, version and interface
+ *   IDs, readable with fourdst::plugin::inspect without loading the library
  * 
  * @param className The C++ class name that implements the plugin interface
  * @param pluginName A string literal containing the plugin's name
@@ -110,6 +217,10 @@ namespace fourdst::plugin {
  * @note This macro must be used exactly once per plugin library
  * @note The className must be a complete type at the point of macro expansion
  * @note The className must be default-constructible
+ * @note pluginName and pluginVersion must be string literals, since they are
+ *       embedded in the metadata note at compile time
+ * @note The manager trusts the note's name to detect name collisions before a
+ *       plugin is loaded, so get_name() should report pluginName
  * 
  * Example usage:
  * @code
@@ -121,6 +232,7 @@ namespace fourdst::plugin {
  * @endcode
  */
 #define FOURDST_DECLARE_PLUGIN(className, pluginName, pluginVersion)                \
+    FOURDST_PLUGIN_NOTE(className, pluginName, pluginVersion)                       \
     FOURDST_PLUGIN_EXPORT fourdst::plugin::IPlugin* create_plugin() {               \
         static_assert(std::is_base_of_v<fourdst::plugin::PluginBase,                \
             className>,                                                             \
@@ -129,5 +241,146 @@ namespace fourdst::plugin {
     }                                                                               \
     FOURDST_PLUGIN_EXPORT void destroy_plugin(fourdst::plugin::IPlugin* plugin) {   \
         delete plugin;                                                              \
+    }                                                                               \
+    FOURDST_PLUGIN_EXPORT const fourdst::plugin::interface_id_t*                   \
+    get_plugin_interfaces(std::size_t* count) {                                     \
+        *count = className::fourdst_interface_ids.size();                           \
+        return className::fourdst_interface_ids.data();                             \
+    }
+
+/**
+ * @brief Macro to give a plugin interface a compile-time interface ID
+ *
+ * Place this macro at the top of an interface class body. It declares the
+ * interface's ID, records it in the hierarchy's ID list and overrides
+ * IPlugin::query_interface so that PluginManager::get<T>() can resolve the
+ * interface without dynamic_cast. Interfaces that do not use the macro keep
+ * working through the dynamic_cast fallback.
+ *
+ * @param interfaceName The interface class being declared
+ * @param baseName The direct base class of the interface (PluginBase, another
+ *                 declared interface, or a template such as FunctorPlugin_T<T>)
+ * @param interfaceIdName A string literal that uniquely names the interface
+ *
+ * @note The macro leaves the class in a public access section
+ * @note The ID is a hash of interfaceIdName; pick names that are unique across
+ *       every interface a host may load (e.g. "myapp.IFilter/1")
+ *
+ * Example usage:
+ * @code
+ * class IMyInterface : public fourdst::plugin::PluginBase {
+ *     FOURDST_DECLARE_INTERFACE(IMyInterface, fourdst::plugin::PluginBase, "myapp.IMyInterface/1");
+ * public:
+ *     using PluginBase::PluginBase;
+ *     virtual void do_work() = 0;
+ * };
+ * @endcode
+ */
+#define FOURDST_DECLARE_INTERFACE(interfaceName, baseName, interfaceIdName)                             \
+    public:                                                                                             \
+    using fourdst_interface_type = interfaceName;                                                       \
+    static constexpr fourdst::plugin::interface_id_t interface_id =                                     \
+        fourdst::plugin::make_interface_id(interfaceIdName);                                            \
+    static constexpr auto fourdst_interface_ids =                                                       \
+        fourdst::plugin::append_interface_id(baseName::fourdst_interface_ids, interface_id);            \
+    [[nodiscard]] void* query_interface(const fourdst::plugin::interface_id_t id) noexcept override {  \
+        if (id == interface_id) {                                                                       \
+            return static_cast<interfaceName*>(this);                                                   \
+        }                                                                                               \
+        return baseName::query_interface(id);                                                           \
     }
 
+/**
+ * @brief Macro to declare how a plugin class may be called from several threads
+ *
+ * Place this macro in the body of a plugin class (or of an interface, for all
+ * of its implementations). It records the trait as the static member
+ * fourdst_concurrency and overrides IPlugin::concurrency(), so executors can
+ * share, replicate or serialize the plugin instead of locking conservatively.
+ * Classes that do not use the macro report Concurrency::Serialized.
+ *
+ * @param trait One of the fourdst::plugin::Concurrency enumerators, unqualified:
+ *              Pure, Reentrant, PerThreadInstance or Serialized
+ *
+ * @note The macro leaves the class in a public access section
+ * @note The trait is a promise about every method the executors call, e.g.
+ *       operator(), transform() and apply() of a FunctorPlugin_T
+ *
+ * Example usage:
+ * @code
+ * class Scale final : public fourdst::plugin::templates::FunctorPlugin_T<double> {
+ *     FOURDST_DECLARE_CONCURRENCY(Pure);
+ *     using FunctorPlugin_T::FunctorPlugin_T;
+ *     double operator()(const double& x) const override { return 2 * x; }
+ * };
+ * @endcode
+ */
+#define FOURDST_DECLARE_CONCURRENCY(trait)                                                          \
+    public:                                                                                         \
+    static constexpr fourdst::plugin::Concurrency fourdst_concurrency =                             \
+        fourdst::plugin::Concurrency::trait;                                                        \
+    [[nodiscard]] fourdst::plugin::Concurrency concurrency() const noexcept override {              \
+        return fourdst_concurrency;                                                                 \
+    }
+
+/**
+ * @brief Macro to give a plugin a warm-up step run by the manager after loading
+ *
+ * Exports warmup_plugin(), which calls className::warmup() on the instance
+ * created by FOURDST_DECLARE_PLUGIN. PluginManager runs it on a background
+ * thread pool right after the plugin is loaded; hosts call
+ * PluginManager::wait_until_warm() before taking traffic. A reloaded plugin is
+ * warmed before it replaces the running one.
+ *
+ * @param className The plugin class passed to FOURDST_DECLARE_PLUGIN; it must
+ *                  have an accessible member function void warmup()
+ *
+ * @note warmup() may run concurrently with calls made through the manager, and
+ *       must not call PluginManager::wait_until_warm() itself
+ * @note An exception thrown by warmup() does not unload the plugin; it is
+ *       reported by PluginManager::warmup_failures()
+ *
+ * Example usage:
+ * @code
+ * FOURDST_DECLARE_PLUGIN(MyPlugin, "my_plugin", "1.0.0");
+ * FOURDST_DECLARE_PLUGIN_WARMUP(MyPlugin);
+ * @endcode
+ */
+#define FOURDST_DECLARE_PLUGIN_WARMUP(className)                                    \
+    FOURDST_PLUGIN_EXPORT void warmup_plugin(fourdst::plugin::IPlugin* plugin) {    \
+        static_cast<className*>(plugin)->warmup();                                  \
+    }
+
+/**
+ * @brief Macro to export C structs of function pointers alongside the plugin class
+ *
+ * Exports get_plugin_function_table(), through which PluginManager::get_function_table
+ * hands the tables to the host. Calling through a table is a plain indirect call,
+ * without the vtable load of a virtual call, and tables can offer batch entry points
+ * that process a whole array per call. The plugin class and its interfaces keep
+ * working as usual; tables are an optional addition.
+ *
+ * @param ... One or more constant table objects, whose types satisfy
+ *            fourdst::plugin::FunctionTable and have distinct table IDs
+ *
+ * @note This macro must be used at most once per plugin library
+ *
+ * Example usage:
+ * @code
+ * // Shared with the host:
+ * struct KernelTable {
+ *     static constexpr fourdst::plugin::interface_id_t table_id = fourdst::plugin::make_interface_id("myapp.KernelTable/1");
+ *     double (*apply)(double x);
+ *     void (*apply_all)(double* values, std::size_t count);
+ * };
+ *
+ * // In the plugin:
+ * constexpr KernelTable kKernels{&apply, &apply_all};
+ * FOURDST_DECLARE_FUNCTION_TABLES(kKernels);
+ * @endcode
+ */
+#define FOURDST_DECLARE_FUNCTION_TABLES(...)                                                        \
+    FOURDST_PLUGIN_EXPORT const void* get_plugin_function_table(fourdst::plugin::interface_id_t id, \
+                                                                std::size_t* size) {                \
+        return fourdst::plugin::find_function_table(id, size, __VA_ARGS__);                         \
+    }
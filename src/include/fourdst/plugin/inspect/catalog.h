@@ -0,0 +1,90 @@
+/**
+ * @file catalog.h
+ * @brief Catalog of the plugin libraries in a directory, cached on disk
+ *
+ * A catalog lists every shared library in a plugin directory together with the
+ * metadata read from its note (see inspect.h). Scanning persists the catalog to
+ * an index file; the next scan trusts the index for every library whose size
+ * and modification time are unchanged and only inspects new or modified files.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "fourdst/plugin/inspect/inspect.h"
+
+namespace fourdst::plugin {
+
+    /**
+     * @brief Name of the index file scan_directory() keeps in the scanned directory by default
+     */
+    inline constexpr char kCatalogFileName[] = ".fourdst-plugin-catalog";
+
+    /**
+     * @brief One shared library found by scan_directory()
+     */
+    struct CatalogEntry {
+        std::filesystem::path path;                 ///< Path of the library (directory / file name)
+        std::uintmax_t size = 0;                    ///< File size in bytes when it was last inspected
+        std::filesystem::file_time_type mtime{};    ///< Modification time when it was last inspected
+        std::optional<PluginMetadata> metadata;     ///< Plugin metadata, or std::nullopt if the library has no note
+    };
+
+    /**
+     * @brief Result of scanning a plugin directory
+     */
+    struct PluginCatalog {
+        std::vector<CatalogEntry> entries;  ///< Every shared library in the directory, ordered by path
+        std::size_t inspected = 0;          ///< Libraries whose file had to be read during this scan
+        std::size_t cached = 0;             ///< Libraries taken from the index without reading the file
+
+        /**
+         * @brief Find the entry of the plugin with the given name
+         *
+         * @return The first entry whose metadata names the plugin, or nullptr
+         */
+        [[nodiscard]] const CatalogEntry* find(std::string_view plugin_name) const noexcept {
+            for (const auto& entry : entries) {
+                if (entry.metadata && entry.metadata->name == plugin_name) {
+                    return &entry;
+                }
+            }
+            return nullptr;
+        }
+    };
+
+    /**
+     * @brief Catalog the shared libraries in a directory, reusing and refreshing an on-disk index
+     *
+     * Every regular file in the directory (not recursively) with the platform's
+     * shared library extension is listed. A library whose size and modification
+     * time match its record in the index is taken from the index and never
+     * opened; all other libraries are read with inspect(), concurrently. If
+     * anything changed the index is rewritten (atomically, via a temporary file).
+     *
+     * @param directory The plugin directory to scan
+     * @param cache_file The index file; defaults to directory / kCatalogFileName
+     * @return PluginCatalog The libraries found, and how many came from the index
+     *
+     * @throw std::filesystem::filesystem_error If the directory cannot be listed
+     *
+     * @note A missing, unreadable or corrupt index is treated as empty, and failing
+     *       to write the index is ignored: the index only ever saves work
+     *
+     * Example usage:
+     * @code
+     * const auto catalog = fourdst::plugin::scan_directory("plugins");
+     * if (const auto* entry = catalog.find("my_plugin")) {
+     *     manager.load(entry->path);
+     * }
+     * @endcode
+     */
+    [[nodiscard]] PluginCatalog scan_directory(const std::filesystem::path& directory, const std::filesystem::path& cache_file = {});
+
+}
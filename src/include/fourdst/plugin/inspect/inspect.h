@@ -0,0 +1,53 @@
+/**
+ * @file inspect.h
+ * @brief Read a plugin library's metadata without loading it
+ *
+ * Plugins declared with FOURDST_DECLARE_PLUGIN embed their name, version and
+ * interface IDs in an ELF note (see plugin_note.h). inspect() maps the library
+ * file read-only and parses that note directly, so it neither runs the dynamic
+ * loader, relocations and static constructors, nor instantiates the plugin.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "fourdst/plugin/iplugin.h"
+
+namespace fourdst::plugin {
+
+    /**
+     * @brief Metadata recorded in a plugin library by FOURDST_DECLARE_PLUGIN
+     */
+    struct PluginMetadata {
+        std::string name;                           ///< Name passed to FOURDST_DECLARE_PLUGIN
+        std::string version;                        ///< Version passed to FOURDST_DECLARE_PLUGIN
+        std::vector<interface_id_t> interface_ids;  ///< Interfaces declared along the plugin class hierarchy
+        std::uint32_t abi_version = 0;              ///< Layout version of the note the metadata was read from
+    };
+
+    /**
+     * @brief Read a plugin library's metadata note without loading the library
+     *
+     * @param library_path Path to the shared library file to inspect
+     * @return std::optional<PluginMetadata> The metadata, or std::nullopt if the
+     *         file cannot be read, is not a 64-bit ELF object of the host's byte
+     *         order, or carries no metadata note of a supported ABI version
+     * @throw Never throws for unreadable or malformed files
+     *
+     * @note Only implemented for ELF platforms; returns std::nullopt elsewhere
+     *
+     * Example usage:
+     * @code
+     * if (const auto metadata = fourdst::plugin::inspect("plugins/libfoo.so")) {
+     *     std::cout << metadata->name << " " << metadata->version << std::endl;
+     * }
+     * @endcode
+     */
+    [[nodiscard]] std::optional<PluginMetadata> inspect(const std::filesystem::path& library_path);
+
+}
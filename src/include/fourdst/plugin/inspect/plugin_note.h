@@ -0,0 +1,126 @@
+/**
+ * @file plugin_note.h
+ * @brief Layout of the plugin metadata note embedded by FOURDST_DECLARE_PLUGIN
+ *
+ * Every plugin declared with FOURDST_DECLARE_PLUGIN carries a small ELF note in
+ * a section named ".note.fourdst.plugin" that records the plugin's name,
+ * version and interface IDs. The note is assembled at compile time, so reading
+ * it back (see fourdst::plugin::inspect) requires neither loading the library
+ * nor running any of its code.
+ *
+ * Note layout (all integers in the byte order of the target):
+ * @code
+ * u32 namesz = 8, u32 descsz, u32 type = kPluginNoteType, "fourdst\0"
+ * desc:
+ *   u32 abi_version, u32 name_size, u32 version_size, u32 interface_count
+ *   u64 interface_ids[interface_count]
+ *   char name[name_size]          (NUL terminated)
+ *   char version[version_size]    (NUL terminated)
+ *   padding to a multiple of 4 bytes
+ * @endcode
+ */
+
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+#include "fourdst/plugin/iplugin.h"
+
+namespace fourdst::plugin::note {
+
+    /**
+     * @brief Version of the note layout; bumped whenever the layout changes
+     */
+    inline constexpr std::uint32_t kPluginNoteAbiVersion = 1;
+
+    /**
+     * @brief ELF note type of the plugin metadata note
+     */
+    inline constexpr std::uint32_t kPluginNoteType = 0x46445031; // "FDP1"
+
+    /**
+     * @brief Owner name of the plugin metadata note, including the terminating NUL
+     */
+    inline constexpr char kPluginNoteOwner[] = "fourdst";
+
+    /**
+     * @brief Name of the section holding the plugin metadata note
+     */
+    inline constexpr char kPluginNoteSection[] = ".note.fourdst.plugin";
+
+    /**
+     * @brief Size in bytes of the fixed part of the note descriptor
+     */
+    inline constexpr std::size_t kPluginNoteDescHeaderSize = 4 * sizeof(std::uint32_t);
+
+    namespace detail {
+        constexpr std::size_t align4(const std::size_t size) noexcept {
+            return (size + 3) & ~std::size_t{3};
+        }
+
+        template<typename Int, std::size_t Size>
+        constexpr void put(std::array<unsigned char, Size>& out, std::size_t& offset, const Int value) noexcept {
+            const auto bytes = std::bit_cast<std::array<unsigned char, sizeof(Int)>>(value);
+            for (const unsigned char byte : bytes) {
+                out[offset++] = byte;
+            }
+        }
+    }
+
+    /**
+     * @brief Total size in bytes of a plugin note with the given contents
+     *
+     * @param name_size Size of the plugin name including its terminating NUL
+     * @param version_size Size of the plugin version including its terminating NUL
+     * @param interface_count Number of interface IDs
+     */
+    constexpr std::size_t plugin_note_size(const std::size_t name_size, const std::size_t version_size, const std::size_t interface_count) noexcept {
+        return 3 * sizeof(std::uint32_t) + detail::align4(sizeof(kPluginNoteOwner)) +
+               detail::align4(kPluginNoteDescHeaderSize + interface_count * sizeof(interface_id_t) + name_size + version_size);
+    }
+
+    /**
+     * @brief Assemble a plugin metadata note at compile time
+     *
+     * @param name The plugin name as a string literal
+     * @param version The plugin version as a string literal
+     * @param interface_ids The interface IDs the plugin implements
+     * @return The note bytes, ready to be placed in the note section
+     */
+    template<std::size_t NameSize, std::size_t VersionSize, std::size_t InterfaceCount>
+    constexpr std::array<unsigned char, plugin_note_size(NameSize, VersionSize, InterfaceCount)>
+    make_plugin_note(const char (&name)[NameSize], const char (&version)[VersionSize],
+                     const std::array<interface_id_t, InterfaceCount>& interface_ids) noexcept {
+        constexpr std::size_t total = plugin_note_size(NameSize, VersionSize, InterfaceCount);
+        constexpr std::size_t header = 3 * sizeof(std::uint32_t) + detail::align4(sizeof(kPluginNoteOwner));
+
+        std::array<unsigned char, total> out{};
+        std::size_t offset = 0;
+        detail::put(out, offset, static_cast<std::uint32_t>(sizeof(kPluginNoteOwner)));
+        detail::put(out, offset, static_cast<std::uint32_t>(total - header));
+        detail::put(out, offset, kPluginNoteType);
+        for (const char c : kPluginNoteOwner) {
+            out[offset++] = static_cast<unsigned char>(c);
+        }
+        offset = header;
+
+        detail::put(out, offset, kPluginNoteAbiVersion);
+        detail::put(out, offset, static_cast<std::uint32_t>(NameSize));
+        detail::put(out, offset, static_cast<std::uint32_t>(VersionSize));
+        detail::put(out, offset, static_cast<std::uint32_t>(InterfaceCount));
+        for (const interface_id_t id : interface_ids) {
+            detail::put(out, offset, id);
+        }
+        for (const char c : name) {
+            out[offset++] = static_cast<unsigned char>(c);
+        }
+        for (const char c : version) {
+            out[offset++] = static_cast<unsigned char>(c);
+        }
+        return out;
+    }
+
+}
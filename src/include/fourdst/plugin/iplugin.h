@@ -9,7 +9,103 @@
 
 #pragma once
 
+#include <concepts>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
 namespace fourdst::plugin {
+    /**
+     * @brief Numeric identifier of a plugin interface
+     *
+     * Interface IDs are 64-bit FNV-1a hashes of a unique interface name and are
+     * computed at compile time (see make_interface_id and FOURDST_DECLARE_INTERFACE).
+     */
+    using interface_id_t = std::uint64_t;
+
+    /**
+     * @brief Compute the interface ID for a given interface name at compile time
+     *
+     * @param interface_name A name that uniquely identifies the interface, e.g. a
+     *                       fully qualified, versioned string such as "myapp.IFilter/1"
+     * @return interface_id_t The 64-bit FNV-1a hash of the name
+     * @throw Never throws
+     */
+    constexpr interface_id_t make_interface_id(const std::string_view interface_name) noexcept {
+        interface_id_t hash = 14695981039346656037ull;
+        for (const char c : interface_name) {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    /**
+     * @brief How a plugin instance may be called from several threads
+     *
+     * Declared by a plugin class with FOURDST_DECLARE_CONCURRENCY and reported by
+     * IPlugin::concurrency(). Executors such as pipeline::Pipeline use it to choose
+     * between sharing, replicating and serializing a plugin (see execution_mode).
+     */
+    enum class Concurrency : std::uint8_t {
+        Serialized,         ///< Calls must never overlap, not even on separate instances (e.g. global state); the default
+        PerThreadInstance,  ///< Calls on one instance must not overlap, but separate instances are independent
+        Reentrant,          ///< Calls on one instance may overlap; the plugin synchronizes its own state
+        Pure,               ///< No mutable state: calls may overlap, and their results do not depend on each other
+    };
+
+    /**
+     * @brief How an executor runs a plugin on several threads
+     */
+    enum class ExecutionMode : std::uint8_t {
+        Shared,      ///< All threads call the same instance
+        Replicated,  ///< Each thread calls an instance of its own
+        Serialized,  ///< One thread at a time calls the instance
+    };
+
+    /**
+     * @brief The execution mode an executor should pick for a concurrency trait
+     *
+     * @throw Never throws
+     */
+    constexpr ExecutionMode execution_mode(const Concurrency concurrency) noexcept {
+        switch (concurrency) {
+            case Concurrency::Pure:
+            case Concurrency::Reentrant:
+                return ExecutionMode::Shared;
+            case Concurrency::PerThreadInstance:
+                return ExecutionMode::Replicated;
+            case Concurrency::Serialized:
+                break;
+        }
+        return ExecutionMode::Serialized;
+    }
+
+    /**
+     * @brief Satisfied by interface types that declare their own interface ID
+     *
+     * Only the class that used FOURDST_DECLARE_INTERFACE satisfies the concept;
+     * classes deriving from it inherit the ID but are not the interface it names.
+     */
+    template<typename T>
+    concept DeclaresInterfaceId = requires {
+        typename T::fourdst_interface_type;
+        { T::interface_id } -> std::convertible_to<interface_id_t>;
+    } && std::is_same_v<typename T::fourdst_interface_type, std::remove_cv_t<T>>;
+
+    /**
+     * @brief Satisfied by C structs of function pointers that plugins can export as a function table
+     *
+     * A table declares a table_id, conventionally made with make_interface_id from a
+     * versioned name such as "myapp.KernelTable/1". Tables may grow by appending
+     * members; any other change to the layout needs a new ID. See
+     * FOURDST_DECLARE_FUNCTION_TABLES and PluginManager::get_function_table.
+     */
+    template<typename T>
+    concept FunctionTable = std::is_standard_layout_v<T> && std::is_trivially_copyable_v<T> && requires {
+        { T::table_id } -> std::convertible_to<interface_id_t>;
+    };
+
     /**
      * @brief Abstract base interface for all plugins
      * 
@@ -19,7 +115,12 @@ namespace fourdst::plugin {
      * interfaces that define domain-specific functionality.
      * 
      * @note This is a pure abstract interface - it cannot be instantiated directly.
-     * @note All derived classes should ensure thread-safety of the implemented methods.
+     * @note All derived classes should ensure thread-safety of the implemented methods,
+     *       and declare how far they do with FOURDST_DECLARE_CONCURRENCY.
+     * @note query_interface() and concurrency() extended the vtable of this class.
+     *       The manager only calls them on plugins whose library exports
+     *       get_plugin_interfaces (as FOURDST_DECLARE_PLUGIN does), and uses
+     *       dynamic_cast and Concurrency::Serialized for older binaries instead.
      */
     class IPlugin {
     public:
@@ -65,5 +166,37 @@ namespace fourdst::plugin {
          * @note Version strings should follow semantic versioning (e.g., "1.0.0").
          */
         [[nodiscard]] virtual const char* get_version() const = 0;
+
+        /**
+         * @brief Query the plugin for an interface by its compile-time ID
+         *
+         * This is an RTTI-free alternative to dynamic_cast. Interfaces opt in by
+         * using FOURDST_DECLARE_INTERFACE, which overrides this method to answer
+         * for its own ID and forward every other ID to its base class.
+         *
+         * @param id The interface ID to query (see make_interface_id)
+         * @return void* A pointer to this object converted to the interface with the
+         *               given ID, or nullptr if the plugin does not declare it
+         * @throw Never throws
+         *
+         * @note The returned pointer must only be converted back to the exact
+         *       interface type that declared the ID.
+         */
+        [[nodiscard]] virtual void* query_interface(interface_id_t id) noexcept {
+            (void)id;
+            return nullptr;
+        }
+
+        /**
+         * @brief Get how the plugin may be called from several threads
+         *
+         * Plugin classes declare it with FOURDST_DECLARE_CONCURRENCY; the default
+         * makes no promise and reports Concurrency::Serialized.
+         *
+         * @throw Never throws
+         */
+        [[nodiscard]] virtual Concurrency concurrency() const noexcept {
+            return Concurrency::Serialized;
+        }
     };
 }
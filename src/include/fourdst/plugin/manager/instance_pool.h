@@ -0,0 +1,215 @@
+/**
+ * @file instance_pool.h
+ * @brief Pool of independent instances of one plugin, checked out and returned by callers
+ *
+ * Every plugin normally has a single instance owned by the PluginManager, so a
+ * stateful plugin used from several threads has to synchronize internally. An
+ * InstancePool instead hands each caller an instance of its own for the
+ * duration of a Lease, creating instances on demand through the plugin's
+ * factory and keeping returned ones for reuse.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "fourdst/plugin/manager/plugin_manager.h"
+
+namespace fourdst::plugin::manager {
+
+    /**
+     * @brief Thread-safe pool of instances of a single plugin
+     *
+     * checkout() returns an idle instance if there is one and creates a new one
+     * with PluginManager::create_instance otherwise; the Lease puts the instance
+     * back when it is destroyed. Instances created before the plugin was
+     * unloaded, reloaded or evicted are never handed out again: they are
+     * destroyed when they come back to (or are found in) the pool.
+     *
+     * @tparam T The plugin interface type the pool hands out
+     *
+     * @note The pool must not outlive the manager, and leases must not outlive the pool
+     * @note Instances keep their library open, so they stay usable after the plugin
+     *       is unloaded; they are destroyed through the library's destroy_plugin
+     *
+     * Example usage:
+     * @code
+     * fourdst::plugin::manager::InstancePool<IFilter> filters(manager, "filter");
+     * parallel_for(chunks, [&](auto& chunk) {
+     *     auto filter = filters.checkout(); // no other thread uses this instance
+     *     filter->run(chunk);
+     * });
+     * @endcode
+     */
+    template<typename T>
+    class InstancePool {
+    public:
+        /**
+         * @brief Exclusive use of one pooled instance, returned to the pool on destruction
+         */
+        class Lease {
+        public:
+            /**
+             * @brief Construct an empty lease that holds no instance
+             */
+            Lease() = default;
+
+            ~Lease() { release(); }
+
+            Lease(Lease&& other) noexcept :
+                m_pool(std::exchange(other.m_pool, nullptr)), m_instance(std::move(other.m_instance)), m_generation(other.m_generation) {}
+
+            Lease& operator=(Lease&& other) noexcept {
+                if (this != &other) {
+                    release();
+                    m_pool = std::exchange(other.m_pool, nullptr);
+                    m_instance = std::move(other.m_instance);
+                    m_generation = other.m_generation;
+                }
+                return *this;
+            }
+
+            Lease(const Lease&) = delete;
+            Lease& operator=(const Lease&) = delete;
+
+            /**
+             * @brief Get the leased instance
+             *
+             * @return T* The instance, or nullptr for an empty lease
+             * @throw Never throws
+             */
+            [[nodiscard]] T* get() const noexcept { return m_instance.get(); }
+
+            T* operator->() const noexcept { return m_instance.get(); }
+            T& operator*() const noexcept { return *m_instance; }
+            explicit operator bool() const noexcept { return m_instance != nullptr; }
+
+            /**
+             * @brief Return the instance to the pool early, leaving the lease empty
+             */
+            void release() {
+                if (m_pool) {
+                    std::exchange(m_pool, nullptr)->give_back(std::move(m_instance), m_generation);
+                }
+            }
+
+        private:
+            friend class InstancePool;
+
+            Lease(InstancePool* pool, std::shared_ptr<T> instance, const std::uint64_t generation) noexcept :
+                m_pool(pool), m_instance(std::move(instance)), m_generation(generation) {}
+
+            InstancePool* m_pool = nullptr;
+            std::shared_ptr<T> m_instance;
+            std::uint64_t m_generation = 0; ///< Generation of the plugin the instance was created from
+        };
+
+        /**
+         * @brief Create an empty pool for a plugin
+         *
+         * @param manager The manager the plugin is loaded into
+         * @param plugin_name The name of the plugin to pool
+         * @param max_idle How many returned instances are kept; further ones are destroyed.
+         *        Defaults to the number of hardware threads
+         *
+         * @note The plugin does not need to be loaded yet; checkout() requires it to be
+         */
+        InstancePool(const PluginManager& manager, std::string plugin_name,
+                     const std::size_t max_idle = std::max(1u, std::thread::hardware_concurrency())) :
+            m_manager(manager), m_plugin_name(std::move(plugin_name)), m_max_idle(max_idle) {}
+
+        InstancePool(const InstancePool&) = delete;
+        InstancePool& operator=(const InstancePool&) = delete;
+        InstancePool(InstancePool&&) = delete;
+        InstancePool& operator=(InstancePool&&) = delete;
+
+        /**
+         * @brief Take an instance out of the pool, creating one if none is idle
+         *
+         * @return Lease The instance, exclusively the caller's until the lease is destroyed
+         *
+         * @throw fourdst::plugin::exception::PluginNotLoadedError If a new instance is
+         *        needed and the plugin is not loaded or registered
+         * @throw fourdst::plugin::exception::PluginTypeError If the plugin is not of type T
+         * @throw Whatever PluginManager::create_instance throws
+         */
+        [[nodiscard]] Lease checkout() {
+            std::vector<Idle> stale; // Destroyed after the lock is released
+            {
+                std::lock_guard lock(m_mutex);
+                while (!m_idle.empty()) {
+                    Idle idle = std::move(m_idle.back());
+                    m_idle.pop_back();
+                    if (is_current(idle.generation)) {
+                        return Lease(this, std::move(idle.instance), idle.generation);
+                    }
+                    stale.push_back(std::move(idle));
+                }
+            }
+
+            PluginManager::SpawnedPlugin spawned = m_manager.spawn_raw(m_plugin_name);
+            T* plugin = PluginManager::cast_plugin<T>({spawned.instance.get(), spawned.indexed}, m_plugin_name);
+            {
+                std::lock_guard lock(m_mutex);
+                m_generation_cell = spawned.generation_cell;
+            }
+            return Lease(this, std::shared_ptr<T>(std::move(spawned.instance), plugin), spawned.generation);
+        }
+
+        /**
+         * @brief Get the number of instances waiting in the pool
+         */
+        [[nodiscard]] std::size_t idle() const {
+            std::lock_guard lock(m_mutex);
+            return m_idle.size();
+        }
+
+        /**
+         * @brief Destroy every idle instance; leased instances are not affected
+         */
+        void clear() {
+            std::vector<Idle> idle;
+            std::lock_guard lock(m_mutex);
+            idle.swap(m_idle);
+        }
+
+    private:
+        struct Idle {
+            std::shared_ptr<T> instance;
+            std::uint64_t generation = 0;
+        };
+
+        /**
+         * @pre m_mutex is held by the caller.
+         */
+        [[nodiscard]] bool is_current(const std::uint64_t generation) const noexcept {
+            return m_generation_cell && m_generation_cell->load(std::memory_order_acquire) == generation;
+        }
+
+        void give_back(std::shared_ptr<T> instance, const std::uint64_t generation) {
+            std::lock_guard lock(m_mutex);
+            if (is_current(generation) && m_idle.size() < m_max_idle) {
+                m_idle.push_back({std::move(instance), generation});
+                return;
+            }
+            // Stale or surplus: instance is destroyed on return, after the lock is released
+        }
+
+        const PluginManager& m_manager;
+        std::string m_plugin_name;
+        std::size_t m_max_idle;
+        mutable std::mutex m_mutex;
+        std::vector<Idle> m_idle; ///< Returned instances, most recently returned last
+        const std::atomic<std::uint64_t>* m_generation_cell = nullptr; ///< Manager-owned generation counter for the plugin name
+    };
+
+}
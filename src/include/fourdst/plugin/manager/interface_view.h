@@ -0,0 +1,96 @@
+/**
+ * @file interface_view.h
+ * @brief Read-only view over all loaded plugins implementing an interface
+ *
+ * An InterfaceView is what PluginManager::find_all<T>() returns. It shares an
+ * immutable list of interface pointers with the manager's interface index, so
+ * obtaining and copying a view costs a reference count increment.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace fourdst::plugin::manager {
+
+    class PluginManager;
+
+    /**
+     * @brief Immutable, random-access view of plugins implementing interface T
+     *
+     * The view is a snapshot: plugins loaded after it was obtained are not
+     * included, and plugins unloaded afterwards remain listed (their pointers
+     * must then no longer be dereferenced).
+     *
+     * @tparam T The plugin interface type the view yields
+     *
+     * @note The order of the plugins in the view is unspecified
+     *
+     * Example usage:
+     * @code
+     * for (IDataSeriesProcessor* processor : manager.find_all<IDataSeriesProcessor>()) {
+     *     series = (*processor)(series);
+     * }
+     * @endcode
+     */
+    template<typename T>
+    class InterfaceView {
+    public:
+        /**
+         * @brief Random-access iterator yielding T*
+         */
+        class iterator {
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = T*;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = T*;
+
+            iterator() = default;
+            explicit iterator(std::vector<void*>::const_iterator it) : m_it(it) {}
+
+            T* operator*() const { return static_cast<T*>(*m_it); }
+            T* operator[](difference_type n) const { return static_cast<T*>(m_it[n]); }
+            iterator& operator++() { ++m_it; return *this; }
+            iterator operator++(int) { iterator tmp = *this; ++m_it; return tmp; }
+            iterator& operator--() { --m_it; return *this; }
+            iterator operator--(int) { iterator tmp = *this; --m_it; return tmp; }
+            iterator& operator+=(difference_type n) { m_it += n; return *this; }
+            iterator& operator-=(difference_type n) { m_it -= n; return *this; }
+            friend iterator operator+(iterator it, difference_type n) { return it += n; }
+            friend iterator operator+(difference_type n, iterator it) { return it += n; }
+            friend iterator operator-(iterator it, difference_type n) { return it -= n; }
+            friend difference_type operator-(const iterator& a, const iterator& b) { return a.m_it - b.m_it; }
+            friend auto operator<=>(const iterator&, const iterator&) = default;
+
+        private:
+            std::vector<void*>::const_iterator m_it;
+        };
+
+        /**
+         * @brief Construct an empty view
+         */
+        InterfaceView() = default;
+
+        [[nodiscard]] iterator begin() const { return m_interfaces ? iterator(m_interfaces->cbegin()) : iterator(); }
+        [[nodiscard]] iterator end() const { return m_interfaces ? iterator(m_interfaces->cend()) : iterator(); }
+        [[nodiscard]] std::size_t size() const noexcept { return m_interfaces ? m_interfaces->size() : 0; }
+        [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+        T* operator[](std::size_t index) const { return static_cast<T*>((*m_interfaces)[index]); }
+
+    private:
+        friend class PluginManager;
+
+        explicit InterfaceView(std::shared_ptr<const std::vector<void*>> interfaces) noexcept :
+            m_interfaces(std::move(interfaces)) {}
+
+        /// Interface pointers, each already converted to T* and stored as void*
+        std::shared_ptr<const std::vector<void*>> m_interfaces;
+    };
+
+}
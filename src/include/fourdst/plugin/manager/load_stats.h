@@ -0,0 +1,94 @@
+/**
+ * @file load_stats.h
+ * @brief Per-plugin timings and memory figures of the load pipeline
+ *
+ * A PluginManager with load statistics enabled (see
+ * PluginManager::enable_load_stats) records one PluginLoadStats per load
+ * attempt, split into the phases of the load pipeline. The records can be
+ * queried through PluginManager::load_stats() or dumped as JSON with to_json().
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace fourdst::plugin::manager {
+
+    /**
+     * @brief Timings and memory figures of loading one plugin library
+     *
+     * Phases that were not reached (because an earlier one failed) are zero.
+     */
+    struct PluginLoadStats {
+        std::filesystem::path path;             ///< The library that was loaded
+        std::string name;                       ///< Name of the plugin; empty if a load failed before the plugin reported it
+        bool loaded = false;                    ///< Whether the plugin ended up registered
+        std::string error;                      ///< Why the load failed, if it did
+
+        std::chrono::nanoseconds inspect{0};    ///< Reading the metadata note for the name collision pre-check
+        std::chrono::nanoseconds stat{0};       ///< Checking that the library file exists
+        std::chrono::nanoseconds dlopen{0};     ///< dlopen or dlmopen, including relocations and static initializers
+        std::chrono::nanoseconds symbols{0};    ///< Resolving the plugin entry points
+        std::chrono::nanoseconds create{0};     ///< create_plugin, i.e. the plugin's constructor
+        std::chrono::nanoseconds name_check{0}; ///< Name collision check and registry update
+        std::chrono::nanoseconds total{0};      ///< Sum of the phases
+
+        /**
+         * @brief Change of the process's resident set size across dlopen and symbol resolution, in bytes
+         *
+         * @note Process-wide, so anything else running at the same time is included
+         */
+        std::int64_t rss_delta = 0;
+        std::uint64_t mapped_size = 0;          ///< Bytes spanned by the library's loadable segments
+    };
+
+    /**
+     * @brief The load statistics recorded by a PluginManager
+     */
+    struct LoadStats {
+        std::vector<PluginLoadStats> plugins; ///< One record per load attempt, in the order the attempts finished
+
+        /**
+         * @brief Find the most recent record of the plugin with the given name
+         *
+         * @return The record, or nullptr if the plugin has not been loaded since recording began
+         */
+        [[nodiscard]] const PluginLoadStats* find(std::string_view plugin_name) const noexcept {
+            for (auto it = plugins.rbegin(); it != plugins.rend(); ++it) {
+                if (it->name == plugin_name) {
+                    return &*it;
+                }
+            }
+            return nullptr;
+        }
+
+        /**
+         * @brief Sum of the total time of every record
+         */
+        [[nodiscard]] std::chrono::nanoseconds total() const noexcept {
+            std::chrono::nanoseconds sum{0};
+            for (const auto& plugin : plugins) {
+                sum += plugin.total;
+            }
+            return sum;
+        }
+    };
+
+    /**
+     * @brief Serialize load statistics as a JSON document
+     *
+     * Durations are written in nanoseconds, under the phase name with an "_ns" suffix.
+     *
+     * @code
+     * {"plugins": [{"path": "...", "name": "...", "loaded": true, "error": "",
+     *               "inspect_ns": 0, ..., "total_ns": 0, "rss_delta": 0, "mapped_size": 0}]}
+     * @endcode
+     */
+    [[nodiscard]] std::string to_json(const LoadStats& stats);
+
+}
@@ -0,0 +1,121 @@
+/**
+ * @file plugin_handle.h
+ * @brief Typed, pre-resolved handles to plugins owned by a PluginManager
+ *
+ * A handle is obtained once through PluginManager::resolve<T>() and then
+ * dereferenced without any name lookup or cast. A generation counter shared
+ * with the manager makes it possible to detect handles that outlived an unload.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include "fourdst/plugin/exception/exceptions.h"
+
+namespace fourdst::plugin::manager {
+
+    class PluginManager;
+
+    /**
+     * @brief Pre-resolved, typed reference to a loaded plugin
+     *
+     * The handle stores the already cast T* alongside the generation the plugin
+     * was loaded with. Dereferencing is a single pointer load; checking validity
+     * is one additional atomic load compared against the stored generation.
+     *
+     * @tparam T The plugin interface type the handle was resolved to
+     *
+     * @note Handles are cheap to copy and do not keep the plugin alive. Once the
+     *       plugin is unloaded the handle becomes stale and must not be dereferenced.
+     * @note The generation counter for a plugin name lives as long as the manager
+     *       that produced the handle.
+     *
+     * Example usage:
+     * @code
+     * auto op = manager.resolve<IMathOperation>("add");
+     * for (...) {
+     *     sum = op->apply(sum, x); // no lookup, no dynamic_cast
+     * }
+     * if (!op.is_valid()) { ... } // the plugin was unloaded in the meantime
+     * @endcode
+     */
+    template<typename T>
+    class PluginHandle {
+    public:
+        /**
+         * @brief Construct an empty handle that refers to no plugin
+         */
+        PluginHandle() = default;
+
+        /**
+         * @brief Get the plugin pointer without checking for staleness
+         *
+         * @return T* The resolved plugin, or nullptr for an empty handle
+         * @throw Never throws
+         */
+        [[nodiscard]] T* get() const noexcept { return m_plugin; }
+
+        /**
+         * @brief Access the plugin without checking for staleness
+         *
+         * @throw Never throws
+         */
+        T* operator->() const noexcept { return m_plugin; }
+
+        /**
+         * @brief Dereference the plugin without checking for staleness
+         *
+         * @throw Never throws
+         */
+        T& operator*() const noexcept { return *m_plugin; }
+
+        /**
+         * @brief Check whether the plugin this handle was resolved to is still loaded
+         *
+         * @return true If the handle is non-empty and its plugin has not been unloaded since
+         * @throw Never throws
+         */
+        [[nodiscard]] bool is_valid() const noexcept {
+            return m_plugin != nullptr && m_generation_cell->load(std::memory_order_acquire) == m_generation;
+        }
+
+        /**
+         * @brief Equivalent to is_valid()
+         */
+        explicit operator bool() const noexcept { return is_valid(); }
+
+        /**
+         * @brief Get the plugin pointer, verifying that the handle is not stale
+         *
+         * @return T* The resolved plugin
+         * @throw fourdst::plugin::exception::PluginNotLoadedError If the handle is
+         *        empty or the plugin has been unloaded since it was resolved
+         */
+        [[nodiscard]] T* checked_get() const {
+            if (!is_valid()) {
+                throw exception::PluginNotLoadedError("PluginHandle::checked_get: the plugin referenced by this handle has been unloaded");
+            }
+            return m_plugin;
+        }
+
+        /**
+         * @brief Get the load generation this handle was resolved against
+         *
+         * @return std::uint64_t The generation, or 0 for an empty handle
+         */
+        [[nodiscard]] std::uint64_t generation() const noexcept { return m_generation; }
+
+    private:
+        friend class PluginManager;
+
+        PluginHandle(T* plugin, const std::atomic<std::uint64_t>* generation_cell, const std::uint64_t generation) noexcept :
+            m_plugin(plugin), m_generation_cell(generation_cell), m_generation(generation) {}
+
+        T* m_plugin = nullptr; ///< Resolved and cast plugin pointer
+        const std::atomic<std::uint64_t>* m_generation_cell = nullptr; ///< Manager-owned generation counter for the plugin name
+        std::uint64_t m_generation = 0; ///< Generation observed at resolve time
+    };
+
+}
@@ -10,15 +10,136 @@
 #pragma once
 
 
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <expected>
 #include <filesystem>
 #include <memory>
+#include <span>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #include "fourdst/plugin/exception/exceptions.h"
+#include "fourdst/plugin/exception/error_code.h"
 #include "fourdst/plugin/iplugin.h"
+#include "fourdst/plugin/inspect/catalog.h"
+#include "fourdst/plugin/manager/interface_view.h"
+#include "fourdst/plugin/manager/load_stats.h"
+#include "fourdst/plugin/manager/plugin_handle.h"
 
 namespace fourdst::plugin::manager {
 
+    template<typename T>
+    class InstancePool;
+
+    /**
+     * @brief How the dynamic loader opens a plugin library
+     *
+     * The defaults reproduce the historical behaviour (RTLD_LAZY | RTLD_GLOBAL).
+     * Every library opened with a global scope adds its exported symbols to the
+     * process-wide lookup scope, which every later relocation has to search, so
+     * hosts loading many plugins should prefer a local scope.
+     *
+     * Example usage:
+     * @code
+     * fourdst::plugin::manager::LoadOptions options;
+     * options.scope = fourdst::plugin::manager::LoadOptions::Scope::Local;
+     * options.binding = fourdst::plugin::manager::LoadOptions::Binding::Now;
+     * manager.load("plugins/libfoo.so", options);
+     * @endcode
+     */
+    struct LoadOptions {
+        /**
+         * @brief When the library's function symbols are bound
+         */
+        enum class Binding {
+            Lazy, ///< On first call (RTLD_LAZY)
+            Now   ///< Before dlopen returns, surfacing missing symbols at load time (RTLD_NOW)
+        };
+
+        /**
+         * @brief Whether the library's symbols become visible to libraries opened later
+         */
+        enum class Scope {
+            Global, ///< Added to the global lookup scope (RTLD_GLOBAL)
+            Local   ///< Only visible through the library's own handle (RTLD_LOCAL)
+        };
+
+        Binding binding = Binding::Lazy;
+        Scope scope = Scope::Global;
+
+        /**
+         * @brief Prefer the library's own symbols over global ones with the same name (RTLD_DEEPBIND)
+         *
+         * @note Only available with glibc; loading fails with PluginLoadError elsewhere
+         */
+        bool deep_bind = false;
+
+        /**
+         * @brief Open the library in a separate link-map namespace shared by this group (dlmopen)
+         *
+         * Libraries loaded with the same non-empty group share one namespace, created
+         * when the first of them is loaded and released with the last one. A namespace
+         * has its own copy of every dependency, including the C++ runtime, so nothing
+         * the plugin defines or depends on can clash with the host or other groups.
+         * Empty means the default namespace.
+         *
+         * @note Only available with glibc; loading fails with PluginLoadError elsewhere
+         * @note The plugin cannot resolve symbols from the host executable, glibc
+         *       supports only a small number of namespaces (typically 16), and the
+         *       scope is always local within the namespace
+         * @note Exceptions and RTTI do not cross namespace boundaries reliably; use
+         *       interfaces declared with FOURDST_DECLARE_INTERFACE for such plugins
+         */
+        std::string namespace_group;
+
+        /**
+         * @brief Extra exported symbols resolved and cached when the library is opened
+         *
+         * Each name is looked up once at load time, so get_symbol() never has to call
+         * dlsym for it, and a library lacking any of them fails to load with
+         * PluginSymbolError instead of failing later at the first lookup.
+         */
+        std::vector<std::string> required_symbols;
+    };
+
+    /**
+     * @brief A library that could not be loaded by PluginManager::load_all
+     */
+    struct LoadFailure {
+        std::filesystem::path path; ///< Path of the library that failed
+        std::string message;        ///< Description of the failure (the exception's what())
+        std::exception_ptr error;   ///< The exception load() would have thrown for this path
+    };
+
+    /**
+     * @brief A plugin whose warm-up (see FOURDST_DECLARE_PLUGIN_WARMUP) threw
+     */
+    struct WarmupFailure {
+        std::string plugin_name;    ///< Name of the plugin, which stays loaded
+        std::string message;        ///< Description of the failure (the exception's what())
+        std::exception_ptr error;   ///< The exception thrown by warmup()
+    };
+
+    /**
+     * @brief Aggregated outcome of a PluginManager::load_all batch
+     */
+    struct LoadReport {
+        std::vector<std::string> loaded;    ///< Names of the plugins that were loaded
+        std::vector<LoadFailure> failures;  ///< Libraries that were not loaded, and why
+
+        /**
+         * @brief Whether every library in the batch was loaded
+         */
+        [[nodiscard]] bool ok() const noexcept { return failures.empty(); }
+    };
+
     /**
      * @brief Central manager for plugin loading and lifecycle management
      * 
@@ -28,20 +149,72 @@ namespace fourdst::plugin::manager {
      * - Managing plugin lifetimes and cleanup
      * - Providing type-safe access to loaded plugins
      * - Preventing name collisions between plugins
+     * - Deferring the loading of rarely used plugins until their first use
      * 
      * The manager uses the PIMPL idiom to hide implementation details and maintain
      * ABI stability. It automatically handles proper cleanup of all loaded plugins
      * when the manager is destroyed.
      * 
+     * @note Managers are independent of each other; getInstance() returns a default one
      * @note This class is not copyable or movable to prevent issues with plugin handles
      * @note All plugin access is thread-safe at the manager level, but individual
      *       plugin instances may not be thread-safe
+     * @note The name -> plugin registry is read-copy-update: lookups (get, has) read
+     *       an immutable snapshot without taking any lock, while load and unload are
+     *       serialized, publish a new snapshot and wait for in-flight lookups to finish
+     *       before the replaced snapshot (and any unloaded plugin) is released.
+     *       The first lookup of a lazily registered plugin is the exception: it loads
+     *       the plugin like load() before returning it.
+     * @note Code that calls into a plugin while another thread may unload or reload
+     *       it should hold a ReadGuard (see pin()) for the duration of the call; the
+     *       plugin is then not destroyed before the guard is released.
      */
     class PluginManager {
     public:
 
+        /**
+         * @brief Get the process-wide default manager
+         *
+         * Created on first use and destroyed at process exit. Code that does not
+         * need isolation between groups of plugins can share this manager; it is
+         * also the one PluginBundle loads into unless given another.
+         *
+         * @return PluginManager& The default manager
+         */
         static PluginManager& getInstance();
 
+        /**
+         * @brief Construct an empty manager, independent of every other manager
+         *
+         * Each manager has its own registry, writer lock, reader epochs, idle
+         * eviction thread and dlmopen namespace groups, so loading, unloading or
+         * pinning plugins in one manager never waits on another. Plugin names only
+         * need to be unique within a manager.
+         *
+         * @note A library loaded into several managers is mapped only once by the
+         *       dynamic loader, so its global variables are shared between them (each
+         *       manager still gets its own plugin instance). Loading it into a
+         *       namespace group avoids that; groups are per manager as well
+         *
+         * Example usage:
+         * @code
+         * fourdst::plugin::manager::PluginManager tenant_a;
+         * fourdst::plugin::manager::PluginManager tenant_b;
+         * tenant_a.load("plugins/libfilter.so");
+         * tenant_b.load("plugins/libfilter.so"); // separate instance, no collision
+         * @endcode
+         */
+        PluginManager();
+
+        /**
+         * @brief Destroy the manager, unloading every plugin it holds
+         *
+         * @note No other thread may use the manager, or a plugin pointer or handle
+         *       obtained from it, once destruction has begun. Instances from
+         *       create_instance() remain usable
+         */
+        ~PluginManager();
+
         /**
          * @brief Copy constructor (deleted)
          * 
@@ -74,6 +247,55 @@ namespace fourdst::plugin::manager {
          */
         PluginManager& operator=(PluginManager&&) = delete;
 
+        /**
+         * @brief Keeps the plugins visible to the calling thread alive while it exists
+         *
+         * While a guard is held, no plugin that could be looked up when the guard was
+         * created (or while it is held) is destroyed or has its library closed, even
+         * if it is unloaded, reloaded or evicted concurrently: the manager frees such
+         * plugins only once every guard that might still reference them has been
+         * released. Creating and releasing a guard never blocks or takes a lock.
+         *
+         * @note A guard must be released on the thread that created it; guards nest
+         * @note Writers wait for outstanding guards, so hold guards briefly. A thread
+         *       may load, unload or reload while holding a guard: the call does not
+         *       wait for readers, and the plugins it replaces are freed after the guard
+         *       is released. The first access to a lazily registered plugin may wait
+         *       for another thread's load of that plugin to finish, never for readers
+         *
+         * Example usage:
+         * @code
+         * {
+         *     const auto guard = manager.pin();
+         *     auto* filter = manager.get<IFilter>("filter");
+         *     filter->run(data); // safe even if "filter" is reloaded meanwhile
+         * }
+         * @endcode
+         */
+        class ReadGuard {
+        public:
+            ~ReadGuard();
+            ReadGuard(const ReadGuard&) = delete;
+            ReadGuard& operator=(const ReadGuard&) = delete;
+            ReadGuard(ReadGuard&&) = delete;
+            ReadGuard& operator=(ReadGuard&&) = delete;
+
+        private:
+            friend class PluginManager;
+            explicit ReadGuard(const PluginManager& manager);
+
+            const PluginManager* m_manager;
+        };
+
+        /**
+         * @brief Enter a read-side section that keeps looked-up plugins alive
+         *
+         * @return ReadGuard The guard; the section ends when it is destroyed
+         * @throw std::bad_alloc If this is the thread's first section on this manager
+         *        and its reader slot cannot be allocated
+         */
+        [[nodiscard]] ReadGuard pin() const;
+
         /**
          * @brief Load a plugin from the specified library path
          * 
@@ -82,6 +304,7 @@ namespace fourdst::plugin::manager {
          * must have a unique name within this manager instance.
          * 
          * @param library_path Path to the shared library file to load
+         * @param options How the dynamic loader opens the library
          * 
          * @throw fourdst::plugin::exception::PluginLoadError If the library file
          *        cannot be found, opened, or if the plugin factory returns nullptr
@@ -91,10 +314,283 @@ namespace fourdst::plugin::manager {
          *        with the same name is already loaded
          * 
          * @note The library_path can be absolute or relative to the current working directory
+         * @note If the library carries a metadata note (FOURDST_DECLARE_PLUGIN), a name
+         *       collision is detected from the note before the library is opened
          * @note Once loaded, the plugin will remain in memory until explicitly unloaded
          *       or the manager is destroyed
          */
-        void load(const std::filesystem::path& library_path) const;
+        void load(const std::filesystem::path& library_path, const LoadOptions& options = {}) const;
+
+        /**
+         * @brief Load a plugin like load(), reporting failure as an error code instead of throwing
+         *
+         * @param library_path Path to the shared library file containing the plugin
+         * @param options How the library is opened (see LoadOptions)
+         * @return The loaded plugin's name, or the code of the exception load() would have thrown
+         *
+         * @throw Never throws
+         *
+         * @note Only the code of a failure is kept; call load() when the loader's
+         *       own message is needed
+         */
+        [[nodiscard]] std::expected<std::string, exception::PluginErrorCode> try_load(const std::filesystem::path& library_path, const LoadOptions& options = {}) const noexcept;
+
+        /**
+         * @brief Load a batch of plugins, reporting failures instead of throwing
+         *
+         * Intended for loading many plugins at startup. The batch is processed in
+         * phases: the library files are read ahead into the page cache in parallel,
+         * the libraries are opened (dlopen is serialized by the dynamic loader),
+         * the plugin factories run concurrently on a thread pool, and finally all
+         * plugins are registered with a single registry update.
+         *
+         * Every library is subject to the same checks as load(). A library that
+         * fails any of them is left unloaded and recorded in the returned report
+         * together with the exception load() would have thrown; the remaining
+         * libraries are still loaded.
+         *
+         * @param library_paths Paths of the shared library files to load
+         * @param options How the dynamic loader opens every library of the batch
+         * @return LoadReport The names of the loaded plugins and the failed paths
+         * @throw Never throws for per-library failures
+         *
+         * @note Plugin factories (create_plugin) of different libraries may run
+         *       concurrently, so they must not rely on unsynchronized shared state
+         * @note If two libraries in the batch report the same plugin name, the one
+         *       listed first is loaded and the other fails with a name collision
+         * @note Metadata notes are read while the files are prefetched, so libraries
+         *       whose note reveals a collision are never opened
+         *
+         * Example usage:
+         * @code
+         * const auto report = manager.load_all(paths);
+         * for (const auto& failure : report.failures) {
+         *     std::cerr << failure.path << ": " << failure.message << std::endl;
+         * }
+         * @endcode
+         */
+        LoadReport load_all(std::span<const std::filesystem::path> library_paths, const LoadOptions& options = {}) const;
+
+        /**
+         * @brief Register a plugin without loading it until it is first needed
+         *
+         * Records the library path under the given plugin name without opening the
+         * library. The first get<T>(), resolve<T>() or has() for that name opens the
+         * library and creates the plugin exactly once, even when several threads
+         * ask for it concurrently; later accesses are ordinary lookups.
+         *
+         * @param library_path Path to the shared library file to load on first use
+         * @param plugin_name The name the plugin reports through get_name()
+         * @param options How the dynamic loader opens the library once it is needed
+         *
+         * @throw fourdst::plugin::exception::PluginNameCollisionError If a plugin
+         *        with the same name is already loaded or registered
+         *
+         * @note Errors from opening the library surface on first access: get<T>()
+         *       and resolve<T>() throw what load() would have thrown, while has()
+         *       returns false. A failed load is retried on the next access.
+         * @note If the plugin reports a name other than plugin_name, first access
+         *       fails with PluginLoadError and the plugin is not loaded
+         * @note A registered plugin that has not been loaded yet is not listed by
+         *       find_all<T>(), since its interfaces are unknown until it is opened
+         * @note unload() removes the registration as well as the loaded plugin
+         *
+         * Example usage:
+         * @code
+         * manager.register_lazy("plugins/librare.so", "RarePlugin");
+         * // ... nothing is opened until here:
+         * auto* rare = manager.get<IRarePlugin>("RarePlugin");
+         * @endcode
+         */
+        void register_lazy(const std::filesystem::path& library_path, const std::string& plugin_name, const LoadOptions& options = {}) const;
+
+        /**
+         * @brief Register a plugin for lazy loading under the name recorded in its metadata note
+         *
+         * Same as register_lazy(library_path, name) with the name read by
+         * fourdst::plugin::inspect, so the library is still not opened.
+         *
+         * @param library_path Path to the shared library file to load on first use
+         * @param options How the dynamic loader opens the library once it is needed
+         *
+         * @throw fourdst::plugin::exception::PluginLoadError If the library carries
+         *        no metadata note (e.g. it was not built with FOURDST_DECLARE_PLUGIN)
+         * @throw fourdst::plugin::exception::PluginNameCollisionError If a plugin
+         *        with the same name is already loaded or registered
+         */
+        void register_lazy(const std::filesystem::path& library_path, const LoadOptions& options = {}) const;
+
+        /**
+         * @brief Catalog a plugin directory and register its plugins for lazy loading
+         *
+         * Builds the directory's catalog with scan_directory(), which trusts its
+         * on-disk index for unchanged libraries and inspects only new or modified
+         * ones, then registers every cataloged plugin with register_lazy() under the
+         * name from its metadata note, in a single registry update. No library is
+         * opened: each plugin is loaded on its first access.
+         *
+         * @param directory The plugin directory to scan
+         * @param cache_file The catalog index file; defaults to directory / kCatalogFileName
+         * @param options How the dynamic loader opens each plugin once it is needed
+         * @return PluginCatalog The catalog the registrations were made from
+         *
+         * @throw std::filesystem::filesystem_error If the directory cannot be listed
+         *
+         * @note Libraries without a metadata note, and plugins whose name is already
+         *       loaded or registered, are listed in the catalog but not registered;
+         *       of several libraries reporting the same name, the first by path wins
+         *
+         * Example usage:
+         * @code
+         * manager.scan("/opt/app/plugins");
+         * auto* filter = manager.get<IFilter>("gaussian_filter"); // opened here
+         * @endcode
+         */
+        PluginCatalog scan(const std::filesystem::path& directory, const std::filesystem::path& cache_file = {}, const LoadOptions& options = {}) const;
+
+        /**
+         * @brief Unload lazily registered plugins that have not been accessed recently
+         *
+         * Every plugin loaded through register_lazy() whose last get<T>(), resolve<T>()
+         * or has() is at least idle_for ago is unloaded, exactly as unload() would, but
+         * keeps its registration: the next access loads it again. Plugins loaded with
+         * load() or load_all() are never evicted.
+         *
+         * @param idle_for Minimum time since the last access for a plugin to be evicted
+         * @return std::size_t The number of plugins that were unloaded
+         *
+         * @note Pointers obtained from get<T>() for an evicted plugin become invalid and
+         *       handles from resolve<T>() become stale, so evictable plugins should be
+         *       fetched again (or their handle checked) after any idle period
+         */
+        std::size_t evict_idle(std::chrono::steady_clock::duration idle_for) const;
+
+        /**
+         * @brief Periodically evict idle lazily registered plugins in the background
+         *
+         * Starts (or reconfigures) a background thread that calls evict_idle(idle_for)
+         * roughly every idle_for / 2. Passing zero stops the thread and disables the
+         * policy, which is also the default.
+         *
+         * @param idle_for Idle period after which a plugin is evicted, or zero to disable
+         */
+        void set_idle_eviction(std::chrono::milliseconds idle_for) const;
+
+        /**
+         * @brief Close the libraries of unloaded plugins on a background thread
+         *
+         * dlclose runs the library's static destructors and unmaps it, which can
+         * take a while for large plugins. While enabled, unload(), reload(),
+         * eviction and the destructor still destroy plugin instances on the calling
+         * thread, but hand the library handles to a reaper thread owned by this
+         * manager. Disabled by default; the setting applies to libraries released
+         * after the call, including those of instances from create_instance().
+         *
+         * @param enabled Whether to defer dlclose to the reaper thread
+         *
+         * @note A path whose library is still waiting for the reaper is reopened
+         *       from the existing mapping; call flush_unloads() before loading a
+         *       rebuilt library from the same path
+         */
+        void set_deferred_unload(bool enabled = true) const;
+
+        /**
+         * @brief Block until the reaper thread has closed every library handed to it
+         */
+        void flush_unloads() const;
+
+        /**
+         * @brief Unload every plugin without closing any library, for use right before process exit
+         *
+         * Plugin instances are destroyed as unload() would destroy them, but their
+         * libraries (and those still queued for the reaper) are left mapped, since
+         * the process is about to exit anyway. Idle eviction and pending warm-ups
+         * are stopped. The manager remains usable afterwards, but never closes a
+         * library again.
+         *
+         * @note Plugin libraries' static destructors do not run
+         */
+        void fast_shutdown() const;
+
+        /**
+         * @brief Block until every plugin warm-up scheduled so far has finished
+         *
+         * Plugins that export a warm-up (see FOURDST_DECLARE_PLUGIN_WARMUP) are warmed
+         * on a background thread pool after load(), load_all() or a lazy load. This
+         * barrier lets a host wait for them before taking traffic. Warm-ups that
+         * threw count as finished and are reported by warmup_failures().
+         *
+         * @note Must not be called from a plugin's warmup()
+         */
+        void wait_until_warm() const;
+
+        /**
+         * @brief Wait at most timeout for every scheduled warm-up to finish
+         *
+         * @param timeout Longest time to wait
+         * @return bool true if no warm-up is queued or running any more
+         */
+        bool wait_until_warm(std::chrono::milliseconds timeout) const;
+
+        /**
+         * @brief Get the warm-ups that threw, in the order they finished
+         */
+        [[nodiscard]] std::vector<WarmupFailure> warmup_failures() const;
+
+        /**
+         * @brief Start or stop recording load statistics
+         *
+         * While enabled, every load(), load_all(), reload() and lazy load records the
+         * time spent in each phase of the load pipeline and the memory the library
+         * takes, successful or not. Disabled by default; disabling keeps the records
+         * made so far.
+         *
+         * @param enabled Whether to record statistics for subsequent loads
+         */
+        void enable_load_stats(bool enabled = true) const;
+
+        /**
+         * @brief Get a copy of the load statistics recorded so far
+         *
+         * @return LoadStats One record per load attempt; see to_json() for a dump
+         */
+        [[nodiscard]] LoadStats load_stats() const;
+
+        /**
+         * @brief Discard the load statistics recorded so far
+         */
+        void clear_load_stats() const;
+
+        /**
+         * @brief Replace a loaded plugin with the one in another library, without downtime
+         *
+         * Opens the new library and creates its plugin first, then swaps it in under
+         * the same name with a single registry update: every lookup sees either the
+         * old or the new plugin, never neither. The old plugin is destroyed and its
+         * library closed once no thread can still be using it (see ReadGuard).
+         *
+         * @param plugin_name The name of the plugin to replace
+         * @param library_path Path to the shared library providing the new version
+         * @param options How the dynamic loader opens the new library
+         *
+         * @throw fourdst::plugin::exception::PluginNotLoadedError If no plugin with the
+         *        given name is loaded or registered
+         * @throw fourdst::plugin::exception::PluginLoadError If the new library cannot be
+         *        loaded, or its plugin reports a name other than plugin_name
+         * @throw fourdst::plugin::exception::PluginSymbolError If the new library lacks
+         *        the plugin entry points
+         *
+         * @note On failure the old plugin stays in place
+         * @note Handles resolved to the old plugin become stale; pointers to it must not be
+         *       used once the caller's ReadGuard (if any) has been released
+         * @note A lazily registered plugin stays lazily registered, now for the new library
+         *
+         * Example usage:
+         * @code
+         * manager.reload("my_plugin", "plugins/v2/libmy_plugin.so");
+         * @endcode
+         */
+        void reload(const std::string& plugin_name, const std::filesystem::path& library_path, const LoadOptions& options = {}) const;
 
         /**
          * @brief Unload a plugin by name
@@ -109,9 +605,22 @@ namespace fourdst::plugin::manager {
          * 
          * @note After unloading, any pointers to the plugin instance become invalid
          * @note The plugin's destructor is guaranteed to be called before the library is closed
+         * @note Blocks until lookups that started before the call have returned, and until
+         *       ReadGuards held by other threads are released; it never blocks lookups
          */
         void unload(const std::string& plugin_name) const;
 
+        /**
+         * @brief Unload a plugin like unload(), reporting whether there was one to unload
+         *
+         * @param plugin_name The name of the plugin to unload
+         * @return Nothing on success, or PluginErrorCode::NotLoaded if no plugin with the
+         *         name was loaded or registered
+         *
+         * @throw Never throws
+         */
+        std::expected<void, exception::PluginErrorCode> try_unload(const std::string& plugin_name) const noexcept;
+
         /**
          * @brief Get a type-safe pointer to a loaded plugin
          * 
@@ -133,6 +642,9 @@ namespace fourdst::plugin::manager {
          *       or the manager is destroyed
          * @note The template parameter T is validated at compile-time to ensure
          *       it inherits from IPlugin
+         * @note If T declares an interface ID (FOURDST_DECLARE_INTERFACE) and the plugin's
+         *       library reports its interfaces, the cast is done with IPlugin::query_interface,
+         *       falling back to dynamic_cast otherwise
          * 
          * Example usage:
          * @code
@@ -143,32 +655,487 @@ namespace fourdst::plugin::manager {
         T* get(const std::string& plugin_name) {
             static_assert(std::is_base_of_v<IPlugin, T>, "T must inherit from IPlugin");
 
-            IPlugin* plugin = get_raw(plugin_name);
+            const RawPlugin plugin = get_raw(plugin_name);
+            if (!plugin.plugin) {
+                throw exception::PluginNotLoadedError(plugin_name + " has not been loaded or does not exist (have you called manager.load()?)");
+            }
+            return cast_plugin<T>(plugin, plugin_name);
+        }
+
+        /**
+         * @brief Get a type-safe pointer to a loaded plugin without throwing
+         *
+         * Intended for request paths where a missing or mismatched plugin is an
+         * expected outcome: a failure costs no allocation or stack unwinding. The
+         * error's description is only built if exception::message() is called.
+         *
+         * @tparam T The plugin interface type to cast to (must inherit from IPlugin)
+         * @param plugin_name The name of the plugin to retrieve
+         * @return The plugin cast to T, or PluginErrorCode::NotLoaded, TypeMismatch or
+         *         (for a lazily registered plugin that failed to load) the load's error
+         *
+         * @throw Never throws
+         *
+         * Example usage:
+         * @code
+         * if (const auto filter = manager.try_get<IFilter>("optional_filter")) {
+         *     (*filter)->apply(frame);
+         * }
+         * @endcode
+         */
+        template<typename T>
+        std::expected<T*, exception::PluginErrorCode> try_get(const std::string& plugin_name) const noexcept {
+            static_assert(std::is_base_of_v<IPlugin, T>, "T must inherit from IPlugin");
+
+            const std::expected<RawPlugin, exception::PluginErrorCode> plugin = try_get_raw(plugin_name);
             if (!plugin) {
+                return std::unexpected(plugin.error());
+            }
+            if (T* casted_plugin = try_cast_plugin<T>(*plugin)) {
+                return casted_plugin;
+            }
+            return std::unexpected(exception::PluginErrorCode::TypeMismatch);
+        }
+
+        /**
+         * @brief Get a typed pointer to a symbol exported by a plugin's library
+         *
+         * For libraries that export C entry points (bulk kernels, version probes, ...)
+         * next to create_plugin and destroy_plugin. The first lookup of a name calls
+         * dlsym; the result, including a miss, is cached with the plugin so later
+         * lookups are a hash table probe. The cache is dropped when the plugin is
+         * unloaded. Names listed in LoadOptions::required_symbols are cached at load time.
+         *
+         * @tparam F The symbol's type: a function type such as int(int), or an object type
+         * @param plugin_name The name of the plugin whose library exports the symbol
+         * @param symbol_name The exported (unmangled) name of the symbol
+         * @return F* The symbol, cast to F*
+         *
+         * @throw fourdst::plugin::exception::PluginNotLoadedError If no plugin with the given name is loaded
+         * @throw fourdst::plugin::exception::PluginSymbolError If the library does not export the symbol
+         * @throw Whatever load() throws if a lazily registered plugin fails to load
+         *
+         * @note F is not checked against the symbol's actual type
+         * @note The pointer is valid until the plugin is unloaded, like the one from get<T>()
+         *
+         * Example usage:
+         * @code
+         * auto* kernel = manager.get_symbol<void(double*, std::size_t)>("my_plugin", "my_plugin_bulk_apply");
+         * kernel(values.data(), values.size());
+         * @endcode
+         */
+        template<typename F>
+        F* get_symbol(const std::string& plugin_name, const std::string_view symbol_name) const {
+            void* symbol = get_symbol_raw(plugin_name, symbol_name);
+            if (!symbol) {
+                throw exception::PluginSymbolError("Could not find '" + std::string(symbol_name) + "' in the library of plugin '" + plugin_name + "'.");
+            }
+            return symbol_cast<F>(symbol);
+        }
+
+        /**
+         * @brief Get a typed pointer to an exported symbol like get_symbol(), without throwing
+         *
+         * @return The symbol, or PluginErrorCode::NotLoaded, MissingSymbol or (for a lazily
+         *         registered plugin that failed to load) the load's error
+         *
+         * @throw Never throws
+         */
+        template<typename F>
+        std::expected<F*, exception::PluginErrorCode> try_get_symbol(const std::string& plugin_name, const std::string_view symbol_name) const noexcept {
+            const std::expected<void*, exception::PluginErrorCode> symbol = try_get_symbol_raw(plugin_name, symbol_name);
+            if (!symbol) {
+                return std::unexpected(symbol.error());
+            }
+            return symbol_cast<F>(*symbol);
+        }
+
+        /**
+         * @brief Get a function table exported by a plugin (see FOURDST_DECLARE_FUNCTION_TABLES)
+         *
+         * The table is a C struct of function pointers, which the host can keep in a
+         * local and call without the vtable indirection of an interface method. The
+         * lookup goes through the get_symbol() cache, so repeated calls are cheap, but
+         * hot loops should fetch the table once.
+         *
+         * @tparam Table The table type shared between host and plugin
+         * @param plugin_name The name of the plugin exporting the table
+         * @return const Table& The plugin's table
+         *
+         * @throw fourdst::plugin::exception::PluginNotLoadedError If no plugin with the given name is loaded
+         * @throw fourdst::plugin::exception::PluginSymbolError If the plugin exports no table with
+         *        Table::table_id, or only one smaller than Table (an older layout)
+         * @throw Whatever load() throws if a lazily registered plugin fails to load
+         *
+         * @note The table is valid until the plugin is unloaded, like the pointer from get<T>()
+         *
+         * Example usage:
+         * @code
+         * const auto& kernels = manager.get_function_table<KernelTable>("my_plugin");
+         * for (double& x : values) {
+         *     x = kernels.apply(x);
+         * }
+         * @endcode
+         */
+        template<FunctionTable Table>
+        const Table& get_function_table(const std::string& plugin_name) const {
+            const void* table = get_function_table_raw(plugin_name, Table::table_id, sizeof(Table));
+            if (!table) {
+                throw exception::PluginSymbolError("Plugin '" + plugin_name + "' does not export a compatible function table of type " + typeid(Table).name() + ".");
+            }
+            return *static_cast<const Table*>(table);
+        }
+
+        /**
+         * @brief Get a function table like get_function_table(), without throwing
+         *
+         * @return The table, or PluginErrorCode::NotLoaded, MissingSymbol or (for a lazily
+         *         registered plugin that failed to load) the load's error
+         *
+         * @throw Never throws
+         */
+        template<FunctionTable Table>
+        std::expected<const Table*, exception::PluginErrorCode> try_get_function_table(const std::string& plugin_name) const noexcept {
+            const std::expected<const void*, exception::PluginErrorCode> table = try_get_function_table_raw(plugin_name, Table::table_id, sizeof(Table));
+            if (!table) {
+                return std::unexpected(table.error());
+            }
+            return static_cast<const Table*>(*table);
+        }
+
+        /**
+         * @brief Resolve a plugin once into a typed handle for repeated access
+         *
+         * Performs the name lookup and type check of get<T>() a single time and
+         * returns a PluginHandle whose dereference is a plain pointer load. The
+         * handle carries the plugin's load generation so that code holding on to
+         * it can detect (via PluginHandle::is_valid) that the plugin was unloaded.
+         *
+         * @tparam T The plugin interface type to cast to (must inherit from IPlugin)
+         * @param plugin_name The name of the plugin to resolve
+         *
+         * @return PluginHandle<T> A handle to the plugin cast to the requested type
+         *
+         * @throw fourdst::plugin::exception::PluginNotLoadedError If no plugin
+         *        with the given name has been loaded
+         * @throw fourdst::plugin::exception::PluginTypeError If the plugin cannot
+         *        be cast to the requested type T
+         *
+         * Example usage:
+         * @code
+         * auto handle = manager.resolve<IMyPluginInterface>("my_plugin");
+         * handle->do_work();
+         * @endcode
+         */
+        template<typename T>
+        PluginHandle<T> resolve(const std::string& plugin_name) {
+            static_assert(std::is_base_of_v<IPlugin, T>, "T must inherit from IPlugin");
+
+            const ResolvedPlugin resolved = resolve_raw(plugin_name);
+            if (!resolved.plugin) {
                 throw exception::PluginNotLoadedError(plugin_name + " has not been loaded or does not exist (have you called manager.load()?)");
             }
+            return PluginHandle<T>(cast_plugin<T>({resolved.plugin, resolved.indexed}, plugin_name), resolved.generation_cell, resolved.generation);
+        }
 
-            T* casted_plugin = dynamic_cast<T*>(plugin);
-            if (!casted_plugin) {
-                throw exception::PluginTypeError("PluginManager::load: plugin " + plugin_name + " is not of type " + typeid(T).name());
+        /**
+         * @brief Enumerate every loaded plugin that implements interface T
+         *
+         * Plugins built with FOURDST_DECLARE_PLUGIN report the interface IDs they
+         * implement when they are loaded, and the manager keeps an index from
+         * interface ID to the plugins implementing it. For interfaces that declare
+         * an ID (FOURDST_DECLARE_INTERFACE) this is a single index lookup that
+         * shares the indexed list with the returned view, so the cost does not
+         * depend on how many unrelated plugins are loaded. Interfaces without an ID,
+         * and plugins that do not report their interfaces, are matched with
+         * dynamic_cast instead. No exceptions are thrown for non-matching plugins.
+         *
+         * @tparam T The plugin interface type to look for (must inherit from IPlugin)
+         * @return InterfaceView<T> A snapshot view of the matching plugins
+         * @throw Never throws for missing plugins (an empty view is returned)
+         *
+         * Example usage:
+         * @code
+         * for (IMathOperation* op : manager.find_all<IMathOperation>()) {
+         *     std::cout << op->get_name() << std::endl;
+         * }
+         * @endcode
+         */
+        template<typename T>
+        InterfaceView<T> find_all() const {
+            static_assert(std::is_base_of_v<IPlugin, T>, "T must inherit from IPlugin");
+
+            constexpr auto cast = [](IPlugin* plugin) -> void* { return dynamic_cast<T*>(plugin); };
+            if constexpr (DeclaresInterfaceId<T>) {
+                return InterfaceView<T>(find_indexed(T::interface_id, cast));
+            } else {
+                return InterfaceView<T>(find_by_cast(cast));
             }
-            return casted_plugin;
         }
 
+        /**
+         * @brief Create a new instance of a loaded plugin, owned by the caller
+         *
+         * Runs the plugin library's factory again, so the returned instance shares no
+         * state with the manager's own instance (the one get() returns) or with other
+         * instances created this way. A lazily registered plugin is loaded first.
+         *
+         * @tparam T The expected plugin interface type (must inherit from IPlugin)
+         * @param plugin_name The name of the plugin to instantiate
+         * @return std::shared_ptr<T> The new instance
+         *
+         * @throw fourdst::plugin::exception::PluginNotLoadedError If no plugin with the given name is loaded
+         * @throw fourdst::plugin::exception::PluginTypeError If the plugin is not of type T
+         * @throw fourdst::plugin::exception::PluginLoadError If the plugin factory returns a nullptr
+         * @throw Whatever load() throws if a lazily registered plugin fails to load
+         *
+         * @note The instance keeps the plugin's library open and is destroyed through the
+         *       library's destroy_plugin, so it remains usable after the plugin is unloaded
+         *       or reloaded, and even after the manager is gone
+         * @note The plugin's create_plugin must therefore return a new, independent
+         *       instance on every call, as the one generated by FOURDST_DECLARE_PLUGIN does
+         *
+         * Example usage:
+         * @code
+         * auto cache = manager.create_instance<ICache>("lru_cache");
+         * cache->put(key, value); // private to this caller
+         * @endcode
+         */
+        template<typename T>
+        std::shared_ptr<T> create_instance(const std::string& plugin_name) const {
+            static_assert(std::is_base_of_v<IPlugin, T>, "T must inherit from IPlugin");
+            SpawnedPlugin spawned = spawn_raw(plugin_name);
+            T* plugin = cast_plugin<T>({spawned.instance.get(), spawned.indexed}, plugin_name);
+            return std::shared_ptr<T>(std::move(spawned.instance), plugin);
+        }
+
+        /**
+         * @brief Get the calling thread's own instance of a loaded plugin
+         *
+         * The first call on a thread creates an instance with create_instance() and
+         * caches it for that thread; later calls return the cached instance after a
+         * generation check, without touching the registry. The instance is replaced
+         * by a fresh one on the first call after the plugin was unloaded, reloaded or
+         * evicted, and destroyed when the thread exits. Instances made from a manager
+         * that has since been destroyed, which keep their libraries mapped, are
+         * released by the thread's next get_local call on any manager.
+         *
+         * @tparam T The expected plugin interface type (must inherit from IPlugin)
+         * @param plugin_name The name of the plugin
+         * @return T* The calling thread's instance; valid on this thread until it exits
+         *         or a later call replaces the instance
+         *
+         * @throw fourdst::plugin::exception::PluginNotLoadedError If no plugin with the given name is loaded
+         * @throw fourdst::plugin::exception::PluginTypeError If the plugin is not of type T
+         * @throw Whatever create_instance() throws
+         *
+         * @note Using a thread's cached instance does not count as an access for idle eviction
+         * @note The pointer must not be handed to other threads unless the plugin itself is thread-safe
+         *
+         * Example usage:
+         * @code
+         * // On every worker thread: a private scratch buffer, no locking inside the plugin
+         * auto* integrator = manager.get_local<IIntegrator>("rk45");
+         * integrator->step(state);
+         * @endcode
+         */
+        template<typename T>
+        T* get_local(const std::string& plugin_name) const {
+            static_assert(std::is_base_of_v<IPlugin, T>, "T must inherit from IPlugin");
+            return cast_plugin<T>(get_local_raw(plugin_name), plugin_name);
+        }
+
+        /**
+         * @brief Check whether a plugin with the given name is available
+         *
+         * @param plugin_name The name of the plugin to look for
+         * @return bool True if the plugin is loaded, or was registered with
+         *         register_lazy() and could be loaded now
+         * @throw Never throws
+         */
         bool has(const std::string& plugin_name) const;
 
+        /**
+         * @brief Concurrency trait of a loaded plugin, see IPlugin::concurrency()
+         *
+         * Unlike calling concurrency() on the plugin, this is safe for plugins built
+         * against headers that predate the trait: their libraries do not report their
+         * interfaces, and they are reported as Concurrency::Serialized.
+         *
+         * @throw fourdst::plugin::exception::PluginNotLoadedError If no plugin with the given name is loaded
+         * @throw Whatever load() throws if a lazily registered plugin fails to load
+         */
+        [[nodiscard]] Concurrency concurrency(const std::string& plugin_name) const;
+
     private:
-        PluginManager();
+        /**
+         * @brief A raw plugin pointer and whether its vtable has the slots of query_interface() and concurrency()
+         */
+        struct RawPlugin {
+            IPlugin* plugin = nullptr;
+            bool indexed = false; ///< The library reports its interfaces, so it was built with both virtuals
+        };
 
-        ~PluginManager();
         /**
          * @brief Internal method to get raw plugin pointer without type checking
          * 
          * @param plugin_name The name of the plugin to retrieve
-         * @return IPlugin* Raw pointer to the plugin, or nullptr if not found
+         * @return RawPlugin Raw pointer to the plugin, nullptr if not found
+         * @throw Whatever load() throws if a lazily registered plugin fails to load
+         */
+        [[nodiscard]] RawPlugin get_raw(const std::string& plugin_name) const;
+
+        /**
+         * @brief Type-erased backend of try_get()
+         *
          * @throw Never throws
          */
-        [[nodiscard]] IPlugin* get_raw(const std::string& plugin_name) const;
+        [[nodiscard]] std::expected<RawPlugin, exception::PluginErrorCode> try_get_raw(const std::string& plugin_name) const noexcept;
+
+        /**
+         * @brief Type-erased backend of get_symbol()
+         *
+         * @return void* The symbol, or nullptr if the library does not export it
+         * @throw fourdst::plugin::exception::PluginNotLoadedError If no plugin with the given name is loaded
+         */
+        [[nodiscard]] void* get_symbol_raw(const std::string& plugin_name, std::string_view symbol_name) const;
+
+        /**
+         * @brief Type-erased backend of try_get_symbol()
+         *
+         * @throw Never throws
+         */
+        [[nodiscard]] std::expected<void*, exception::PluginErrorCode> try_get_symbol_raw(const std::string& plugin_name, std::string_view symbol_name) const noexcept;
+
+        /**
+         * @brief Type-erased backend of get_function_table()
+         *
+         * @return const void* The table, or nullptr if the plugin exports none with the ID of at least min_size bytes
+         * @throw fourdst::plugin::exception::PluginNotLoadedError If no plugin with the given name is loaded
+         */
+        [[nodiscard]] const void* get_function_table_raw(const std::string& plugin_name, interface_id_t table_id, std::size_t min_size) const;
+
+        /**
+         * @brief Type-erased backend of try_get_function_table()
+         *
+         * @throw Never throws
+         */
+        [[nodiscard]] std::expected<const void*, exception::PluginErrorCode> try_get_function_table_raw(const std::string& plugin_name, interface_id_t table_id, std::size_t min_size) const noexcept;
+
+        template<typename F>
+        static F* symbol_cast(void* symbol) noexcept {
+            if constexpr (std::is_function_v<F>) {
+                return reinterpret_cast<F*>(symbol); // Conditionally supported, and always available with dlsym
+            } else {
+                return static_cast<F*>(symbol);
+            }
+        }
+
+        /**
+         * @brief A raw plugin pointer together with the generation it was loaded under
+         */
+        struct ResolvedPlugin {
+            IPlugin* plugin = nullptr;                                  ///< Raw plugin pointer, nullptr if not found
+            const std::atomic<std::uint64_t>* generation_cell = nullptr; ///< Generation counter for the plugin name
+            std::uint64_t generation = 0;                               ///< Generation the plugin was loaded under
+            bool indexed = false;                                       ///< See RawPlugin::indexed
+        };
+
+        /**
+         * @brief Internal method to look up a plugin and its generation from a single registry snapshot
+         *
+         * @param plugin_name The name of the plugin to retrieve
+         * @return ResolvedPlugin The plugin and generation, with a nullptr plugin if not found
+         * @throw Whatever load() throws if a lazily registered plugin fails to load
+         */
+        [[nodiscard]] ResolvedPlugin resolve_raw(const std::string& plugin_name) const;
+
+        /**
+         * @brief A new plugin instance, together with the generation of the plugin it was created from
+         */
+        struct SpawnedPlugin {
+            std::shared_ptr<IPlugin> instance;                           ///< Owns the instance and its library
+            const std::atomic<std::uint64_t>* generation_cell = nullptr; ///< Generation counter for the plugin name
+            std::uint64_t generation = 0;                               ///< Generation the plugin was loaded under
+            bool indexed = false;                                       ///< See RawPlugin::indexed
+        };
+
+        /**
+         * @brief Type-erased backend of create_instance()
+         *
+         * @throw fourdst::plugin::exception::PluginNotLoadedError If no plugin with the given name is loaded
+         */
+        [[nodiscard]] SpawnedPlugin spawn_raw(const std::string& plugin_name) const;
+
+        /**
+         * @brief Type-erased backend of get_local()
+         *
+         * @throw fourdst::plugin::exception::PluginNotLoadedError If no plugin with the given name is loaded
+         */
+        [[nodiscard]] RawPlugin get_local_raw(const std::string& plugin_name) const;
+
+        template<typename T>
+        friend class InstancePool;
+
+        /**
+         * @brief Conversion used for plugins that cannot be served from the interface index
+         */
+        using interface_cast_t = void* (*)(IPlugin*);
+
+        /**
+         * @brief Internal method to list the plugins indexed under an interface ID
+         *
+         * @param id The interface ID to look up in the index
+         * @param cast Conversion applied to plugins that did not report their interfaces
+         * @return The shared index entry, or a merged list if unindexed plugins matched
+         * @throw Never throws
+         */
+        [[nodiscard]] std::shared_ptr<const std::vector<void*>> find_indexed(interface_id_t id, interface_cast_t cast) const;
+
+        /**
+         * @brief Internal method to list the plugins for which cast returns non-null
+         *
+         * @param cast Conversion applied to every loaded plugin
+         * @return The matching plugins, already converted
+         * @throw Never throws
+         */
+        [[nodiscard]] std::shared_ptr<const std::vector<void*>> find_by_cast(interface_cast_t cast) const;
+
+        /**
+         * @brief Internal method to cast a raw plugin to the requested interface type
+         *
+         * Interfaces that declare an ID (FOURDST_DECLARE_INTERFACE) are resolved through
+         * IPlugin::query_interface, which is a single virtual call and integer compare per
+         * level of the hierarchy. Everything else, and plugins whose library does not
+         * report its interfaces (which may predate query_interface), go through dynamic_cast.
+         *
+         * @throw fourdst::plugin::exception::PluginTypeError If the plugin does not implement T
+         */
+        template<typename T>
+        static T* cast_plugin(const RawPlugin plugin, const std::string& plugin_name) {
+            T* casted_plugin = try_cast_plugin<T>(plugin);
+            if (!casted_plugin) {
+                throw exception::PluginTypeError("PluginManager::load: plugin " + plugin_name + " is not of type " + typeid(T).name());
+            }
+            return casted_plugin;
+        }
+
+        /**
+         * @brief Cast a raw plugin to the requested interface type, or return nullptr
+         *
+         * @throw Never throws
+         */
+        template<typename T>
+        static T* try_cast_plugin(const RawPlugin plugin) noexcept {
+            if constexpr (DeclaresInterfaceId<T>) {
+                if (plugin.indexed) {
+                    if (void* interface = plugin.plugin->query_interface(T::interface_id)) {
+                        return static_cast<T*>(interface);
+                    }
+                }
+            }
+            return dynamic_cast<T*>(plugin.plugin);
+        }
 
         struct Impl; ///< Forward declaration for PIMPL implementation
         std::unique_ptr<Impl> pimpl; ///< PIMPL pointer to hide implementation details
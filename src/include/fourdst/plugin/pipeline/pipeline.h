@@ -0,0 +1,369 @@
+/**
+ * @file pipeline.h
+ * @brief Chains of functor plugins run as one unit
+ *
+ * A Pipeline threads a value through a sequence of FunctorPlugin_T<T> stages,
+ * in place and with buffers it keeps between runs, times every stage, and can
+ * process many independent inputs on a thread pool. Stages can be bypassed
+ * without rebuilding the chain.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "fourdst/plugin/manager/instance_pool.h"
+#include "fourdst/plugin/manager/plugin_manager.h"
+#include "fourdst/plugin/profile/latency.h"
+#include "fourdst/plugin/profile/trace.h"
+#include "fourdst/plugin/templates/functor.h"
+#include "fourdst/plugin/utils/thread_pool.h"
+
+namespace fourdst::plugin::pipeline {
+
+    /**
+     * @brief Timings of one stage of a pipeline
+     */
+    struct StageTiming {
+        std::string name;                       ///< Name of the stage's plugin
+        bool bypassed = false;                  ///< Whether the stage is currently skipped
+        profile::LatencyHistogram latency;      ///< One sample per value passed through the stage
+        profile::LatencyHistogram batch_latency; ///< One sample per run_batch() call
+    };
+
+    /**
+     * @brief An ordered chain of functor plugins
+     *
+     * Every entry point runs the stages in the order they were added, skipping
+     * bypassed ones:
+     * - run(const T&) copies the input into a buffer owned by the pipeline and
+     *   transforms it in place, so repeated runs reuse that buffer's storage
+     * - run(T&&) transforms the caller's value in place and hands it back
+     * - run_batch() passes a span of inputs through each stage's apply(),
+     *   alternating between two buffers that only grow
+     * - run_all() transforms many values concurrently on a thread pool
+     *
+     * Stages that override FunctorPlugin_T::transform() and apply() make no
+     * copies on these paths.
+     *
+     * Each stage runs according to its plugin's concurrency trait (see
+     * FOURDST_DECLARE_CONCURRENCY and execution_mode()): Pure and Reentrant
+     * stages are called concurrently, Serialized ones one call at a time, and
+     * PerThreadInstance ones get an instance per run_all() chunk when they were
+     * added through the manager, and are serialized otherwise.
+     *
+     * @tparam T The type of data the stages process
+     *
+     * @note The stages' plugins must outlive the pipeline, i.e. stay loaded (or pinned)
+     * @note run(const T&) and run_batch() use the pipeline's buffers and must not be
+     *       called concurrently; run(T&&) and run_all() may be
+     *
+     * Example usage:
+     * @code
+     * fourdst::plugin::pipeline::Pipeline<DataSeries> pipeline;
+     * pipeline.add(manager, "noise_filter").add(manager, "moving_average");
+     * const DataSeries& result = pipeline.run(series);
+     * for (const auto& stage : pipeline.timings()) {
+     *     std::cout << stage.name << ": " << stage.latency.percentile(50).count() << " ns\n";
+     * }
+     * @endcode
+     */
+    template<typename T>
+    class Pipeline {
+    public:
+        using Stage = templates::FunctorPlugin_T<T>;
+
+        /**
+         * @brief Create an empty pipeline
+         *
+         * @param sample_every Time one in this many passes of each thread per stage; see profile::LatencyRecorder
+         */
+        explicit Pipeline(const std::uint32_t sample_every = 1) : m_sample_every(sample_every) {}
+
+        Pipeline(const Pipeline&) = delete;
+        Pipeline& operator=(const Pipeline&) = delete;
+        Pipeline(Pipeline&&) = default;
+        Pipeline& operator=(Pipeline&&) = default;
+
+        /**
+         * @brief Append a stage
+         *
+         * @param stage The plugin to run after the current last stage
+         * @return Pipeline& This pipeline, for chaining
+         *
+         * @note Asks the plugin for its concurrency trait, so it must have been built
+         *       against headers that have one; add older plugins through the manager
+         */
+        Pipeline& add(const Stage& stage) {
+            return add_slot(stage, stage.concurrency());
+        }
+
+        /**
+         * @brief Append the shared instance of a loaded plugin as a stage
+         *
+         * A plugin declared Concurrency::PerThreadInstance also gets an
+         * InstancePool, from which run_all() takes an instance per chunk.
+         *
+         * @param manager The manager the plugin is loaded into
+         * @param plugin_name The name of the plugin
+         * @return Pipeline& This pipeline, for chaining
+         *
+         * @throw fourdst::plugin::exception::PluginNotLoadedError If the plugin is not loaded
+         * @throw fourdst::plugin::exception::PluginTypeError If the plugin is not a FunctorPlugin_T<T>
+         */
+        Pipeline& add(manager::PluginManager& manager, const std::string& plugin_name) {
+            add_slot(*manager.get<Stage>(plugin_name), manager.concurrency(plugin_name));
+            if (execution_mode(m_stages.back()->concurrency) == ExecutionMode::Replicated) {
+                m_stages.back()->instances = std::make_unique<manager::InstancePool<Stage>>(manager, plugin_name);
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Get the number of stages, bypassed ones included
+         */
+        [[nodiscard]] std::size_t size() const noexcept { return m_stages.size(); }
+
+        /**
+         * @brief Get the plugin of a stage
+         *
+         * @throw std::out_of_range If there is no such stage
+         */
+        [[nodiscard]] const Stage& stage(const std::size_t index) const { return *slot(index).plugin; }
+
+        /**
+         * @brief Skip a stage, or stop skipping it
+         *
+         * Takes effect for passes that start after the call; safe while other threads run the pipeline.
+         *
+         * @throw std::out_of_range If there is no such stage
+         */
+        void set_bypassed(const std::size_t index, const bool bypassed = true) {
+            slot(index).bypassed.store(bypassed, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Check whether a stage is skipped
+         *
+         * @throw std::out_of_range If there is no such stage
+         */
+        [[nodiscard]] bool bypassed(const std::size_t index) const {
+            return slot(index).bypassed.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Run a copy of the input through every stage
+         *
+         * @param input The value to process; not modified
+         * @return const T& The result, held by the pipeline until the next call of run(const T&)
+         *
+         * @throw Whatever the stages throw; the pipeline's buffer is then left partly processed
+         */
+        const T& run(const T& input) {
+            if (m_value) {
+                *m_value = input;
+            } else {
+                m_value.emplace(input);
+            }
+            run_stages(*m_value);
+            return *m_value;
+        }
+
+        /**
+         * @brief Run a value the caller no longer needs through every stage
+         *
+         * @param input The value to process; moved into the result
+         * @return T The result
+         *
+         * @throw Whatever the stages throw
+         */
+        T run(T&& input) {
+            run_stages(input);
+            return std::move(input);
+        }
+
+        /**
+         * @brief Run a batch of independent inputs through every stage's apply()
+         *
+         * @param inputs The values to process; not modified
+         * @return std::span<const T> The results, in the order of the inputs. They live in
+         *         the pipeline's buffers until the next call of run_batch(); if every stage
+         *         is bypassed, the span is inputs itself
+         *
+         * @throw Whatever the stages throw
+         */
+        std::span<const T> run_batch(const std::span<const T> inputs) requires std::default_initializable<T> {
+            reserve(inputs.size());
+            std::span<const T> current = inputs;
+            std::vector<T>* target = &m_front;
+            for (const auto& stage : m_stages) {
+                if (stage->bypassed.load(std::memory_order_relaxed)) {
+                    continue;
+                }
+                const std::span<T> output(target->data(), inputs.size());
+                {
+                    profile::TraceSpan span("pipeline", "apply", stage->plugin->get_name());
+                    profile::ScopedLatency timer(stage->batch_recorder);
+                    if (execution_mode(stage->concurrency) == ExecutionMode::Shared) {
+                        stage->plugin->apply(current, output);
+                    } else {
+                        std::lock_guard lock(*stage->serial);
+                        stage->plugin->apply(current, output);
+                    }
+                }
+                current = output;
+                target = target == &m_front ? &m_back : &m_front;
+            }
+            return current;
+        }
+
+        /**
+         * @brief Grow the buffers of run_batch() to hold at least count values
+         */
+        void reserve(const std::size_t count) requires std::default_initializable<T> {
+            if (m_front.size() < count) {
+                m_front.resize(count);
+                m_back.resize(count);
+            }
+        }
+
+        /**
+         * @brief Run many independent values through every stage on a thread pool
+         *
+         * The values are split into contiguous chunks, a few per worker, and each
+         * chunk is processed in place by one worker.
+         *
+         * @param values The values to process; pass an rvalue to avoid copying them
+         * @param pool The pool to run on; must not be the pool of the calling thread
+         * @return std::vector<T> The results, in the order of the values
+         *
+         * @throw The first exception thrown by a stage, once every chunk has finished
+         */
+        std::vector<T> run_all(std::vector<T> values, utils::ThreadPool& pool) const {
+            constexpr std::size_t kChunksPerWorker = 4;
+            const std::size_t chunks = std::min(values.size(), std::max<std::size_t>(pool.size(), 1) * kChunksPerWorker);
+            std::mutex error_mutex;
+            std::exception_ptr error;
+            pool.parallel_for(chunks, [&](const std::size_t chunk) {
+                const std::size_t begin = values.size() * chunk / chunks;
+                const std::size_t end = values.size() * (chunk + 1) / chunks;
+                try {
+                    std::vector<Lease> leases(m_stages.size()); // Instances of PerThreadInstance stages, taken on first use
+                    for (std::size_t i = begin; i < end; ++i) {
+                        run_stages(values[i], &leases);
+                    }
+                } catch (...) {
+                    std::lock_guard lock(error_mutex);
+                    if (!error) {
+                        error = std::current_exception();
+                    }
+                }
+            });
+            if (error) {
+                std::rethrow_exception(error);
+            }
+            return values;
+        }
+
+        /**
+         * @brief Merge the timings recorded so far by every thread, one entry per stage
+         */
+        [[nodiscard]] std::vector<StageTiming> timings() const {
+            std::vector<StageTiming> result;
+            result.reserve(m_stages.size());
+            for (const auto& stage : m_stages) {
+                result.push_back({std::string(stage->plugin->get_name()), stage->bypassed.load(std::memory_order_relaxed),
+                                  stage->recorder.snapshot(), stage->batch_recorder.snapshot()});
+            }
+            return result;
+        }
+
+    private:
+        using Lease = typename manager::InstancePool<Stage>::Lease;
+
+        struct Slot {
+            Slot(const Stage& stage, const Concurrency trait, const std::uint32_t sample_every) :
+                plugin(&stage), concurrency(trait), recorder(sample_every), batch_recorder(sample_every) {}
+
+            const Stage* plugin;
+            Concurrency concurrency;
+            std::atomic<bool> bypassed{false};
+            std::shared_ptr<std::mutex> serial;                         ///< Shared by every stage of the same plugin
+            std::unique_ptr<manager::InstancePool<Stage>> instances;    ///< Only for PerThreadInstance stages added by name
+            profile::LatencyRecorder recorder;
+            profile::LatencyRecorder batch_recorder;
+        };
+
+        Pipeline& add_slot(const Stage& stage, const Concurrency concurrency) {
+            auto slot = std::make_unique<Slot>(stage, concurrency, m_sample_every);
+            // Calls of a plugin that is added twice must not overlap across its stages either
+            const auto same = std::ranges::find(m_stages, &stage, [](const auto& other) { return other->plugin; });
+            slot->serial = same != m_stages.end() ? (*same)->serial : std::make_shared<std::mutex>();
+            m_stages.push_back(std::move(slot));
+            return *this;
+        }
+
+        [[nodiscard]] Slot& slot(const std::size_t index) const {
+            if (index >= m_stages.size()) {
+                throw std::out_of_range("Pipeline has no stage " + std::to_string(index) + " (it has " +
+                                        std::to_string(m_stages.size()) + ")");
+            }
+            return *m_stages[index];
+        }
+
+        /**
+         * @param leases One lease per stage, owned by the calling thread, or nullptr to
+         *        serialize PerThreadInstance stages on their shared instance instead
+         */
+        void run_stages(T& value, std::vector<Lease>* leases = nullptr) const {
+            for (std::size_t i = 0; i < m_stages.size(); ++i) {
+                Slot& stage = *m_stages[i];
+                if (stage.bypassed.load(std::memory_order_relaxed)) {
+                    continue;
+                }
+                profile::TraceSpan span("pipeline", "stage", stage.plugin->get_name());
+                profile::ScopedLatency timer(stage.recorder);
+                switch (execution_mode(stage.concurrency)) {
+                    case ExecutionMode::Shared:
+                        stage.plugin->transform(value);
+                        break;
+                    case ExecutionMode::Replicated:
+                        if (leases && stage.instances) {
+                            Lease& lease = (*leases)[i];
+                            if (!lease) {
+                                lease = stage.instances->checkout();
+                            }
+                            lease->transform(value);
+                            break;
+                        }
+                        [[fallthrough]];
+                    case ExecutionMode::Serialized: {
+                        std::lock_guard lock(*stage.serial);
+                        stage.plugin->transform(value);
+                        break;
+                    }
+                }
+            }
+        }
+
+        std::uint32_t m_sample_every;
+        std::vector<std::unique_ptr<Slot>> m_stages; ///< Slots are pinned: recorders cannot move
+        std::optional<T> m_value;                    ///< Buffer of run(const T&)
+        std::vector<T> m_front;                      ///< Buffers of run_batch()
+        std::vector<T> m_back;
+    };
+
+}
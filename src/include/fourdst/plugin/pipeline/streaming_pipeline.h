@@ -0,0 +1,547 @@
+/**
+ * @file streaming_pipeline.h
+ * @brief Chains of functor plugins with every stage on a thread of its own
+ *
+ * A StreamingPipeline runs each stage of a chain of FunctorPlugin_T<T> plugins
+ * on dedicated threads and moves items between them through bounded
+ * single-producer single-consumer rings. Its throughput is that of the slowest
+ * stage instead of the sum of all of them, and slow stages can be replicated.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "fourdst/plugin/manager/instance_pool.h"
+#include "fourdst/plugin/manager/plugin_manager.h"
+#include "fourdst/plugin/pipeline/pipeline.h"
+#include "fourdst/plugin/profile/latency.h"
+#include "fourdst/plugin/profile/trace.h"
+#include "fourdst/plugin/templates/functor.h"
+
+namespace fourdst::plugin::pipeline {
+
+    namespace detail {
+        /**
+         * @brief Bounded single-producer single-consumer queue that blocks when full or empty
+         *
+         * The top bit of head marks the end of the stream (set by the producer or
+         * by stop()); the top bit of tail marks a stopped queue (set by stop()).
+         * Waiters spin briefly, then sleep on the index they wait for.
+         */
+        template<typename T>
+        class SpscRing {
+        public:
+            explicit SpscRing(const std::size_t capacity) :
+                m_slots(std::bit_ceil(std::max<std::size_t>(capacity, 2))), m_mask(m_slots.size() - 1) {}
+
+            /**
+             * @brief Append an item, waiting while the ring is full
+             *
+             * @return bool False if the ring was stopped; the item is then dropped
+             */
+            bool push(T&& value) {
+                const std::uint64_t head = m_head.load(std::memory_order_relaxed) & ~kStopBit;
+                unsigned spins = 0;
+                for (;;) {
+                    const std::uint64_t tail = m_tail.load(std::memory_order_acquire);
+                    if (tail & kStopBit) {
+                        return false;
+                    }
+                    if (head - tail <= m_mask) {
+                        break;
+                    }
+                    backoff(m_tail, tail, spins);
+                }
+                m_slots[head & m_mask] = std::move(value);
+                m_head.fetch_add(1, std::memory_order_release);
+                m_head.notify_one();
+                return true;
+            }
+
+            /**
+             * @brief Take the oldest item, waiting while the ring is empty
+             *
+             * @return std::optional<T> The item, or nullopt once the ring is closed and drained, or stopped
+             */
+            std::optional<T> pop() {
+                const std::uint64_t tail = m_tail.load(std::memory_order_relaxed);
+                if (tail & kStopBit) {
+                    return std::nullopt;
+                }
+                unsigned spins = 0;
+                for (;;) {
+                    const std::uint64_t head = m_head.load(std::memory_order_acquire);
+                    if ((head & ~kStopBit) != tail) {
+                        break;
+                    }
+                    if (head & kStopBit) {
+                        return std::nullopt;
+                    }
+                    backoff(m_head, head, spins);
+                    if (m_tail.load(std::memory_order_relaxed) & kStopBit) {
+                        return std::nullopt;
+                    }
+                }
+                std::optional<T> value = std::move(m_slots[tail & m_mask]);
+                m_slots[tail & m_mask].reset();
+                m_tail.fetch_add(1, std::memory_order_release);
+                m_tail.notify_one();
+                return value;
+            }
+
+            /**
+             * @brief Mark the end of the stream; called by the producer after its last push
+             */
+            void close() {
+                m_head.fetch_or(kStopBit, std::memory_order_release);
+                m_head.notify_all();
+            }
+
+            /**
+             * @brief Wake both ends and make every further push and pop fail; callable from any thread
+             */
+            void stop() {
+                m_tail.fetch_or(kStopBit, std::memory_order_release);
+                m_head.fetch_or(kStopBit, std::memory_order_release);
+                m_tail.notify_all();
+                m_head.notify_all();
+            }
+
+        private:
+            static constexpr std::uint64_t kStopBit = std::uint64_t{1} << 63;
+            static constexpr unsigned kSpins = 64; ///< Yields before a waiter goes to sleep
+
+            static void backoff(const std::atomic<std::uint64_t>& index, const std::uint64_t seen, unsigned& spins) {
+                if (++spins < kSpins) {
+                    std::this_thread::yield();
+                } else {
+                    index.wait(seen, std::memory_order_acquire);
+                }
+            }
+
+            std::vector<std::optional<T>> m_slots;
+            const std::uint64_t m_mask;
+            alignas(64) std::atomic<std::uint64_t> m_head{0}; ///< Written by the producer
+            alignas(64) std::atomic<std::uint64_t> m_tail{0}; ///< Written by the consumer
+        };
+    }
+
+    /**
+     * @brief Settings of a StreamingPipeline
+     */
+    struct StreamOptions {
+        std::size_t queue_capacity = 256;  ///< Items buffered per queue; rounded up to a power of two
+        std::uint32_t sample_every = 1;    ///< Time one in this many items per stage replica; see profile::LatencyRecorder
+    };
+
+    /**
+     * @brief A chain of functor plugins run as a stream, one thread per stage replica
+     *
+     * One thread feeds items with push() and another (or the same one, within
+     * the queues' capacity) collects the results with pop(), which returns them
+     * in the order they were pushed. Each stage runs on its own thread and
+     * processes items in place with FunctorPlugin_T::transform().
+     *
+     * A stage with several replicas runs that many threads over the same plugin,
+     * taking items round-robin; every pair of adjacent threads is connected by a
+     * queue of its own, so all queues stay single-producer single-consumer and the
+     * order of items is kept. Whether a stage may be replicated follows from its
+     * plugin's concurrency trait (see FOURDST_DECLARE_CONCURRENCY): replicas of a
+     * Pure or Reentrant plugin share its instance, replicas of a PerThreadInstance
+     * plugin added through the manager each take an instance from an InstancePool,
+     * and any other plugin runs on exactly one thread.
+     *
+     * When a queue is full its producer waits, so a slow consumer holds back every
+     * stage before it (back-pressure) instead of letting memory grow. close() ends
+     * the input; every item pushed before it still comes out of pop(). If a stage
+     * throws, the pipeline stops and pop() and push() rethrow that exception.
+     *
+     * @tparam T The type of data the stages process
+     *
+     * @note The stages' plugins must outlive the pipeline, i.e. stay loaded (or pinned)
+     * @note Destroying a running pipeline stops it and discards the items in flight;
+     *       close() it and pop() until nullopt first to keep them
+     *
+     * Example usage:
+     * @code
+     * fourdst::plugin::pipeline::StreamingPipeline<DataSeries> stream;
+     * stream.add(manager, "libnoise_filter").add(manager, "libmoving_average", 2).add(manager, "libscale_transform");
+     * stream.start();
+     * std::jthread feeder([&] {
+     *     for (auto& series : incoming) {
+     *         stream.push(std::move(series));
+     *     }
+     *     stream.close();
+     * });
+     * while (auto series = stream.pop()) {
+     *     store(*series);
+     * }
+     * @endcode
+     */
+    template<typename T>
+    class StreamingPipeline {
+    public:
+        using Stage = templates::FunctorPlugin_T<T>;
+
+        explicit StreamingPipeline(const StreamOptions& options = {}) : m_options(options) {}
+
+        ~StreamingPipeline() { stop(); }
+
+        StreamingPipeline(const StreamingPipeline&) = delete;
+        StreamingPipeline& operator=(const StreamingPipeline&) = delete;
+        StreamingPipeline(StreamingPipeline&&) = delete;
+        StreamingPipeline& operator=(StreamingPipeline&&) = delete;
+
+        /**
+         * @brief Append a stage
+         *
+         * @param stage The plugin to run after the current last stage
+         * @param replicas Number of threads running the stage; must be at least 1
+         * @return StreamingPipeline& This pipeline, for chaining
+         *
+         * @throw std::invalid_argument If replicas is 0, or if the plugin is not Pure or
+         *        Reentrant and would run on more than one thread: replicated, or already
+         *        used by another stage
+         * @throw std::logic_error If the pipeline has been started
+         *
+         * @note Asks the plugin for its concurrency trait, so it must have been built
+         *       against headers that have one; add older plugins through the manager
+         */
+        StreamingPipeline& add(const Stage& stage, const std::size_t replicas = 1) {
+            return add_slot(stage, stage.concurrency(), replicas, nullptr);
+        }
+
+        /**
+         * @brief Append the shared instance of a loaded plugin as a stage
+         *
+         * Replicas of a plugin declared Concurrency::PerThreadInstance each run an
+         * instance of their own, taken from an InstancePool when the pipeline starts;
+         * so do the replicas of a further stage that reuses such a plugin.
+         *
+         * @throw fourdst::plugin::exception::PluginNotLoadedError If the plugin is not loaded
+         * @throw fourdst::plugin::exception::PluginTypeError If the plugin is not a FunctorPlugin_T<T>
+         * @throw Whatever add(const Stage&, std::size_t) throws
+         */
+        StreamingPipeline& add(manager::PluginManager& manager, const std::string& plugin_name, const std::size_t replicas = 1) {
+            const Stage& stage = *manager.get<Stage>(plugin_name);
+            const Concurrency concurrency = manager.concurrency(plugin_name);
+            std::unique_ptr<manager::InstancePool<Stage>> instances;
+            if (execution_mode(concurrency) == ExecutionMode::Replicated && (replicas > 1 || runs_shared(stage))) {
+                instances = std::make_unique<manager::InstancePool<Stage>>(manager, plugin_name, replicas);
+            }
+            return add_slot(stage, concurrency, replicas, std::move(instances));
+        }
+
+        /**
+         * @brief Get the number of stages
+         */
+        [[nodiscard]] std::size_t size() const noexcept { return m_stages.size(); }
+
+        /**
+         * @brief Create the queues and start one thread per stage replica
+         *
+         * @throw std::logic_error If the pipeline has no stages or has been started before
+         */
+        void start() {
+            if (m_stages.empty()) {
+                throw std::logic_error("StreamingPipeline: cannot start a pipeline without stages");
+            }
+            if (m_started) {
+                throw std::logic_error("StreamingPipeline: the pipeline has already been started");
+            }
+            m_started = true;
+
+            // Boundary b connects the threads of stage b - 1 (or the feeder) to those of stage b (or the collector)
+            m_boundaries.resize(m_stages.size() + 1);
+            for (std::size_t b = 0; b < m_boundaries.size(); ++b) {
+                Boundary& boundary = m_boundaries[b];
+                boundary.producers = b == 0 ? 1 : m_stages[b - 1]->replicas;
+                boundary.consumers = b == m_stages.size() ? 1 : m_stages[b]->replicas;
+                for (std::size_t i = 0; i < boundary.producers * boundary.consumers; ++i) {
+                    boundary.rings.push_back(std::make_unique<Ring>(m_options.queue_capacity));
+                }
+            }
+            for (std::size_t s = 0; s < m_stages.size(); ++s) {
+                for (std::size_t replica = 0; replica < m_stages[s]->replicas; ++replica) {
+                    m_threads.emplace_back([this, s, replica] { run_replica(s, replica); });
+                }
+            }
+        }
+
+        /**
+         * @brief Feed an item into the first stage, waiting while its queue is full
+         *
+         * Must only be called from one thread at a time.
+         *
+         * @throw std::logic_error If the pipeline is not running or its input is closed
+         * @throw The exception of a stage that failed
+         */
+        void push(T value) {
+            if (!m_started || m_closed) {
+                throw std::logic_error("StreamingPipeline: push() needs a started pipeline whose input is open");
+            }
+            const Boundary& input = m_boundaries.front();
+            if (!input.ring(0, m_pushed % input.consumers).push(std::move(value))) {
+                rethrow_failure();
+                throw std::logic_error("StreamingPipeline: the pipeline has been stopped");
+            }
+            ++m_pushed;
+        }
+
+        /**
+         * @brief End the input; every item pushed so far still comes out of pop()
+         */
+        void close() {
+            if (!m_started || m_closed) {
+                return;
+            }
+            m_closed = true;
+            for (const auto& ring : m_boundaries.front().rings) {
+                ring->close();
+            }
+        }
+
+        /**
+         * @brief Take the next result, waiting until it is ready
+         *
+         * Must only be called from one thread at a time.
+         *
+         * @return std::optional<T> The result of the oldest item not yet popped, or
+         *         nullopt once the input is closed and every result has been popped
+         *
+         * @throw std::logic_error If the pipeline has not been started
+         * @throw The exception of a stage that failed
+         */
+        std::optional<T> pop() {
+            if (!m_started) {
+                throw std::logic_error("StreamingPipeline: pop() needs a started pipeline");
+            }
+            const Boundary& output = m_boundaries.back();
+            std::optional<T> value = output.ring(m_popped % output.producers, 0).pop();
+            if (!value) {
+                rethrow_failure();
+                return std::nullopt;
+            }
+            ++m_popped;
+            return value;
+        }
+
+        /**
+         * @brief Stream a batch of values through a started pipeline and collect the results
+         *
+         * Feeds the values from a thread of its own while the calling thread pops,
+         * then closes the input; the pipeline cannot be fed again afterwards.
+         *
+         * @param values The values to process; pass an rvalue to avoid copying them
+         * @return std::vector<T> The results, in the order of the values
+         *
+         * @throw Whatever push() and pop() throw
+         */
+        std::vector<T> run(std::vector<T> values) {
+            if (!m_started) {
+                start();
+            }
+            const std::size_t count = values.size();
+            std::exception_ptr feed_error;
+            std::jthread feeder([&] {
+                try {
+                    for (T& value : values) {
+                        push(std::move(value));
+                    }
+                } catch (...) {
+                    feed_error = std::current_exception();
+                }
+                close();
+            });
+            std::vector<T> results;
+            results.reserve(count);
+            try {
+                while (std::optional<T> value = pop()) {
+                    results.push_back(std::move(*value));
+                }
+            } catch (...) {
+                stop_rings();
+                throw;
+            }
+            feeder.join();
+            if (feed_error) {
+                std::rethrow_exception(feed_error);
+            }
+            return results;
+        }
+
+        /**
+         * @brief Stop every stage and join their threads, discarding the items in flight
+         *
+         * The pipeline cannot be restarted.
+         */
+        void stop() {
+            stop_rings();
+            for (std::jthread& thread : m_threads) {
+                if (thread.joinable()) {
+                    thread.join();
+                }
+            }
+        }
+
+        /**
+         * @brief Merge the timings recorded so far by every replica, one entry per stage
+         */
+        [[nodiscard]] std::vector<StageTiming> timings() const {
+            std::vector<StageTiming> result;
+            result.reserve(m_stages.size());
+            for (const auto& stage : m_stages) {
+                result.push_back({std::string(stage->plugin->get_name()), false, stage->recorder.snapshot(), {}});
+            }
+            return result;
+        }
+
+    private:
+        using Ring = detail::SpscRing<T>;
+
+        struct Slot {
+            Slot(const Stage& stage, const std::size_t replica_count, const std::uint32_t sample_every) :
+                plugin(&stage), replicas(replica_count), recorder(sample_every) {}
+
+            const Stage* plugin;
+            std::size_t replicas;
+            std::unique_ptr<manager::InstancePool<Stage>> instances; ///< One instance per replica, if replicated by instance
+            profile::LatencyRecorder recorder;
+        };
+
+        /**
+         * @brief Whether an existing stage runs the given instance itself rather than instances from a pool
+         */
+        [[nodiscard]] bool runs_shared(const Stage& stage) const {
+            return std::ranges::any_of(m_stages, [&](const auto& other) { return other->plugin == &stage && !other->instances; });
+        }
+
+        StreamingPipeline& add_slot(const Stage& stage, const Concurrency concurrency, const std::size_t replicas,
+                                    std::unique_ptr<manager::InstancePool<Stage>> instances) {
+            if (replicas == 0) {
+                throw std::invalid_argument("StreamingPipeline: a stage needs at least one replica");
+            }
+            if (m_started) {
+                throw std::logic_error("StreamingPipeline: stages cannot be added once the pipeline has started");
+            }
+            if (!instances && execution_mode(concurrency) != ExecutionMode::Shared) {
+                if (replicas > 1 || runs_shared(stage)) {
+                    throw std::invalid_argument(std::string("StreamingPipeline: plugin ") + stage.get_name() +
+                                                " is neither Pure nor Reentrant, so it can only run on one thread" +
+                                                (execution_mode(concurrency) == ExecutionMode::Replicated
+                                                     ? "; add it through the manager to replicate it by instance"
+                                                     : ""));
+                }
+            }
+            auto slot = std::make_unique<Slot>(stage, replicas, m_options.sample_every);
+            slot->instances = std::move(instances);
+            m_stages.push_back(std::move(slot));
+            return *this;
+        }
+
+        struct Boundary {
+            std::size_t producers = 1;
+            std::size_t consumers = 1;
+            std::vector<std::unique_ptr<Ring>> rings; ///< producers x consumers, row-major
+
+            [[nodiscard]] Ring& ring(const std::size_t producer, const std::size_t consumer) const {
+                return *rings[producer * consumers + consumer];
+            }
+        };
+
+        /**
+         * @brief Body of one replica's thread
+         *
+         * Replica r of a stage with n replicas handles items r, r + n, r + 2n, ...
+         * Item i arrives from producer i % (producers) and leaves to consumer
+         * i % (consumers), so every queue carries its items in order.
+         */
+        void run_replica(const std::size_t stage_index, const std::size_t replica) {
+            Slot& stage = *m_stages[stage_index];
+            const Boundary& input = m_boundaries[stage_index];
+            const Boundary& output = m_boundaries[stage_index + 1];
+            typename manager::InstancePool<Stage>::Lease lease;
+            const Stage* plugin = stage.plugin;
+            if (stage.instances) {
+                try {
+                    lease = stage.instances->checkout();
+                    plugin = lease.get();
+                } catch (...) {
+                    fail(std::current_exception());
+                    return;
+                }
+            }
+            for (std::uint64_t item = replica;; item += stage.replicas) {
+                std::optional<T> value = input.ring(item % input.producers, replica).pop();
+                if (!value) {
+                    break;
+                }
+                try {
+                    profile::TraceSpan span("pipeline", "stream", plugin->get_name());
+                    profile::ScopedLatency timer(stage.recorder);
+                    plugin->transform(*value);
+                } catch (...) {
+                    fail(std::current_exception());
+                    return;
+                }
+                if (!output.ring(replica, item % output.consumers).push(std::move(*value))) {
+                    return;
+                }
+            }
+            for (std::size_t consumer = 0; consumer < output.consumers; ++consumer) {
+                output.ring(replica, consumer).close();
+            }
+        }
+
+        void fail(std::exception_ptr error) {
+            {
+                std::lock_guard lock(m_error_mutex);
+                if (!m_error) {
+                    m_error = std::move(error);
+                }
+            }
+            stop_rings();
+        }
+
+        void rethrow_failure() {
+            std::lock_guard lock(m_error_mutex);
+            if (m_error) {
+                std::rethrow_exception(m_error);
+            }
+        }
+
+        void stop_rings() {
+            for (const Boundary& boundary : m_boundaries) {
+                for (const auto& ring : boundary.rings) {
+                    ring->stop();
+                }
+            }
+        }
+
+        StreamOptions m_options;
+        std::vector<std::unique_ptr<Slot>> m_stages;
+        std::vector<Boundary> m_boundaries;
+        bool m_started = false;
+        bool m_closed = false;                    ///< Written by the feeding thread
+        std::uint64_t m_pushed = 0;               ///< Written by the feeding thread
+        std::uint64_t m_popped = 0;               ///< Written by the collecting thread
+        std::mutex m_error_mutex;
+        std::exception_ptr m_error;               ///< First exception thrown by a stage; guarded by m_error_mutex
+        std::vector<std::jthread> m_threads;      ///< Declared last: joined before the queues are destroyed
+    };
+
+}
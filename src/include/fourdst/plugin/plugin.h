@@ -10,9 +10,11 @@
  * - Core plugin interfaces (IPlugin)
  * - Plugin factory and creation macros
  * - Plugin manager for loading and managing plugins
+ * - Metadata inspection of plugin libraries without loading them
  * - Utility functions for plugin development
  * - Exception classes for error handling
  * - Template classes for specialized plugin types
+ * - Pipelines chaining functor plugins
  * 
  * @note This header is designed for convenience. For better compilation times
  *       in large projects, consider including only the specific headers you need.
@@ -22,10 +24,20 @@
 
 #include "fourdst/plugin/iplugin.h"
 #include "fourdst/plugin/factory/plugin_factory.h"
+#include "fourdst/plugin/inspect/inspect.h"
+#include "fourdst/plugin/inspect/catalog.h"
 #include "fourdst/plugin/manager/plugin_manager.h"
+#include "fourdst/plugin/manager/instance_pool.h"
+#include "fourdst/plugin/manager/load_stats.h"
 #include "fourdst/plugin/utils/plugin_utils.h"
 #include "fourdst/plugin/exception/exceptions.h"
+#include "fourdst/plugin/exception/error_code.h"
 #include "fourdst/plugin/templates/functor.h"
+#include "fourdst/plugin/templates/profiled_functor.h"
+#include "fourdst/plugin/pipeline/pipeline.h"
+#include "fourdst/plugin/pipeline/streaming_pipeline.h"
+#include "fourdst/plugin/profile/latency.h"
+#include "fourdst/plugin/profile/trace.h"
 
 /**
  * @brief Main namespace for the FourDST plugin system
@@ -35,6 +47,8 @@
  * 
  * - fourdst::plugin::exception - Exception classes for error handling
  * - fourdst::plugin::manager - Plugin management functionality
+ * - fourdst::plugin::note - Layout of the metadata note embedded in plugin libraries
+ * - fourdst::plugin::pipeline - Chains of functor plugins
  * - fourdst::plugin::templates - Template classes for specialized plugins
  * 
  * The namespace is designed to prevent naming conflicts while providing
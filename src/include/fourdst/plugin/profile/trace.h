@@ -0,0 +1,163 @@
+/**
+ * @file trace.h
+ * @brief Timeline tracing of plugin loads, bundle phases and plugin calls
+ *
+ * While a trace is running, the plugin manager, PluginBundle and profiled
+ * plugin calls emit spans in the Chrome trace-event format, which can be
+ * opened in Perfetto (ui.perfetto.dev) or chrome://tracing. Each thread
+ * appends its spans to a ring buffer of its own, and a background thread
+ * writes them to the trace file, so emitting a span costs two clock reads
+ * and no locks, allocations or I/O. When no trace is running, a span is a
+ * single relaxed atomic load.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+
+namespace fourdst::plugin::profile {
+
+    /**
+     * @brief Settings of a trace
+     */
+    struct TraceOptions {
+        std::size_t ring_capacity = 4096;                  ///< Spans buffered per thread; rounded up to a power of two
+        std::chrono::milliseconds flush_interval{20};      ///< How often the rings are drained to the file
+    };
+
+    /**
+     * @brief Totals of a finished trace
+     */
+    struct TraceSummary {
+        std::uint64_t written = 0; ///< Spans written to the trace file
+        std::uint64_t dropped = 0; ///< Spans lost because a thread's ring was full
+    };
+
+    /**
+     * @brief The process-wide trace-event recorder
+     *
+     * Only one trace runs at a time. Spans are recorded with TraceSpan, or with
+     * record() for spans timed by other means.
+     *
+     * @note A thread that emits spans faster than flush_interval allows for
+     *       its ring_capacity loses the excess; the count is reported by stop()
+     *       and in the trace file's metadata
+     *
+     * Example usage:
+     * @code
+     * fourdst::plugin::profile::Tracer::start("startup.trace.json");
+     * fourdst::plugin::bundle::PluginBundle bundle("plugins.fbundle");
+     * const auto summary = fourdst::plugin::profile::Tracer::stop();
+     * @endcode
+     */
+    class Tracer {
+    public:
+        static constexpr std::size_t kMaxDetail = 48; ///< Bytes of a span's detail text that are kept
+
+        Tracer() = delete;
+
+        /**
+         * @brief Start writing a trace to a file
+         *
+         * @param output Path of the trace-event JSON file; overwritten if it exists
+         * @param options Buffering settings
+         *
+         * @throw std::runtime_error If a trace is already running or the file cannot be opened
+         */
+        static void start(const std::filesystem::path& output, const TraceOptions& options = {});
+
+        /**
+         * @brief Stop the running trace, write out every buffered span and close the file
+         *
+         * Spans that are still open when the trace stops are not written.
+         *
+         * @return TraceSummary Totals of the trace; all zero if no trace was running
+         */
+        static TraceSummary stop();
+
+        /**
+         * @brief Check whether a trace is running
+         */
+        [[nodiscard]] static bool enabled() noexcept { return s_enabled.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Append a finished span to the calling thread's ring buffer
+         *
+         * @param category Category of the span; must be a string literal or otherwise outlive the trace
+         * @param name Name of the span; same lifetime requirement as category
+         * @param detail Free text shown with the span, e.g. a plugin name; copied, and truncated to kMaxDetail bytes
+         * @param start When the span began
+         * @param end When the span ended
+         */
+        static void record(const char* category, const char* name, std::string_view detail,
+                           std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end) noexcept;
+
+        /**
+         * @brief The longest prefix of text that fits kMaxDetail bytes without splitting a UTF-8 sequence
+         */
+        [[nodiscard]] static constexpr std::string_view truncate_detail(const std::string_view text) noexcept {
+            if (text.size() <= kMaxDetail) {
+                return text;
+            }
+            std::size_t length = kMaxDetail;
+            while (length > 0 && (static_cast<unsigned char>(text[length]) & 0xC0) == 0x80) {
+                --length;
+            }
+            return text.substr(0, length);
+        }
+
+    private:
+        static std::atomic<bool> s_enabled;
+    };
+
+    /**
+     * @brief Records its own lifetime as a span of the running trace, if any
+     *
+     * @code
+     * {
+     *     fourdst::plugin::profile::TraceSpan span("host", "warmup", plugin->get_name());
+     *     plugin->warmup();
+     * }
+     * @endcode
+     */
+    class TraceSpan {
+    public:
+        /**
+         * @param category Category of the span; must outlive the trace (e.g. a string literal)
+         * @param name Name of the span; must outlive the trace (e.g. a string literal)
+         * @param detail Free text shown with the span; copied if a trace is running
+         */
+        TraceSpan(const char* category, const char* name, const std::string_view detail = {}) noexcept :
+            m_category(category), m_name(name), m_active(Tracer::enabled()) {
+            if (m_active) {
+                const std::string_view kept = Tracer::truncate_detail(detail);
+                kept.copy(m_detail, kept.size());
+                m_detail_length = kept.size();
+                m_start = std::chrono::steady_clock::now();
+            }
+        }
+
+        ~TraceSpan() {
+            if (m_active) {
+                Tracer::record(m_category, m_name, std::string_view(m_detail, m_detail_length), m_start, std::chrono::steady_clock::now());
+            }
+        }
+
+        TraceSpan(const TraceSpan&) = delete;
+        TraceSpan& operator=(const TraceSpan&) = delete;
+
+    private:
+        const char* m_category;
+        const char* m_name;
+        bool m_active;
+        std::size_t m_detail_length = 0;
+        std::chrono::steady_clock::time_point m_start;
+        char m_detail[Tracer::kMaxDetail];
+    };
+
+}
@@ -9,6 +9,12 @@
 
 #pragma once
 
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
 #include "fourdst/plugin/factory/plugin_factory.h"
 
 namespace fourdst::plugin::templates {
@@ -26,10 +32,14 @@ namespace fourdst::plugin::templates {
      * @tparam T The type of data that this functor plugin processes.
      *           Must be copyable and should typically be movable for performance.
      * 
-     * @note Implementations should ensure the operator() is thread-safe if
-     *       the plugin may be used concurrently
+     * @note Implementations should declare with FOURDST_DECLARE_CONCURRENCY how
+     *       far operator(), transform() and apply() are thread-safe, so that
+     *       pipelines can call them concurrently where that is allowed
      * @note The input parameter is passed by const reference to avoid unnecessary
      *       copying, while the return is by value to ensure proper ownership
+     * @note Callers that own their data can avoid the copy altogether with
+     *       transform() or the consuming operator()(T&&); plugins for expensive
+     *       types should override transform() so that both are copy-free
      * 
      * Example usage:
      * @code
@@ -67,5 +77,80 @@ namespace fourdst::plugin::templates {
          * @note For expensive-to-copy types, consider returning by move when possible
          */
         virtual T operator()(const T& input) const = 0;
+
+        /**
+         * @brief Process an input the caller no longer needs
+         * 
+         * The default implementation transforms the input in place and moves it
+         * into the result, so a plugin that overrides transform() processes an
+         * rvalue without a single copy.
+         * 
+         * @param input The input data to process; left in a valid but unspecified state
+         * 
+         * @return T The processed output data
+         * 
+         * @note Derived classes that override operator()(const T&) hide this
+         *       overload; add `using FunctorPlugin_T<T>::operator();` to call it
+         *       on the derived type
+         */
+        virtual T operator()(T&& input) const {
+            transform(input);
+            return std::move(input);
+        }
+
+        /**
+         * @brief Process data in place
+         * 
+         * Lets a caller thread one buffer through a chain of plugins. The default
+         * implementation bridges to operator()(const T&) and move-assigns the
+         * result, which costs that operator's copy; plugins for expensive types
+         * should override it and implement operator()(const T&) as a copy
+         * followed by transform().
+         * 
+         * @param value The data to process; replaced by the processed output
+         * 
+         * @throw Whatever operator() throws. If an override throws, value may have
+         *        been partly processed; the default leaves it unchanged.
+         */
+        virtual void transform(T& value) const {
+            value = (*this)(std::as_const(value));
+        }
+
+        /**
+         * @brief Process a batch of inputs
+         * 
+         * Writes the result for in[i] to out[i]. The default implementation calls
+         * operator() once per element; plugins with a cheap per-element operation
+         * should override it with a loop the compiler can inline and vectorize,
+         * which removes the virtual call and the copy of the result per element.
+         * 
+         * @param in The inputs to process
+         * @param out Receives the results; must have the size of in. It may be the
+         *            same array as in (processing in place) but must not otherwise overlap it
+         * 
+         * @throw std::invalid_argument If in and out differ in size
+         * @throw Whatever operator() throws
+         * 
+         * @note Overrides should call check_batch(in, out) first
+         */
+        virtual void apply(std::span<const T> in, std::span<T> out) const {
+            check_batch(in, out);
+            for (std::size_t i = 0; i < in.size(); ++i) {
+                out[i] = (*this)(in[i]);
+            }
+        }
+
+    protected:
+        /**
+         * @brief Validate the spans passed to apply()
+         * 
+         * @throw std::invalid_argument If in and out differ in size
+         */
+        static void check_batch(const std::span<const T> in, const std::span<T> out) {
+            if (in.size() != out.size()) {
+                throw std::invalid_argument("FunctorPlugin_T::apply: the output span has " + std::to_string(out.size()) +
+                                            " elements for " + std::to_string(in.size()) + " inputs");
+            }
+        }
     };
 }
\ No newline at end of file
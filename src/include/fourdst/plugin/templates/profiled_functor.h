@@ -0,0 +1,124 @@
+/**
+ * @file profiled_functor.h
+ * @brief Latency-profiling proxy for functor plugins
+ *
+ * Wraps any FunctorPlugin_T<T> so that every call is timed into a per-thread
+ * latency histogram, and traced while a trace is running, without changes to
+ * the plugin or to the code calling it.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <utility>
+
+#include "fourdst/plugin/profile/latency.h"
+#include "fourdst/plugin/profile/trace.h"
+#include "fourdst/plugin/templates/functor.h"
+
+namespace fourdst::plugin::templates {
+    /**
+     * @brief Functor plugin proxy that records the latency of every call it forwards
+     *
+     * The proxy is itself a FunctorPlugin_T<T> with the wrapped plugin's name and
+     * version, so it can be used wherever the plugin itself is. Recording is
+     * lock-free (see profile::LatencyRecorder); latency() merges the threads'
+     * histograms on demand.
+     *
+     * @tparam T The type of data the wrapped functor processes
+     *
+     * @note The wrapped plugin must outlive the proxy, i.e. stay loaded (or pinned)
+     * @note query_interface() is not forwarded, so that calls cannot bypass the proxy
+     *
+     * Example usage:
+     * @code
+     * auto* filter = manager.get<IDataSeriesProcessor>("NoiseFilter");
+     * fourdst::plugin::templates::ProfiledFunctor<DataSeries> profiled(*filter);
+     * for (const auto& series : batches) {
+     *     results.push_back(profiled(series));
+     * }
+     * const auto latency = profiled.latency();
+     * std::cout << "p99: " << latency.percentile(99).count() << " ns\n";
+     * @endcode
+     */
+    template<typename T>
+    class ProfiledFunctor final : public FunctorPlugin_T<T> {
+    public:
+        /**
+         * @brief Wrap a functor plugin
+         *
+         * @param inner The plugin whose calls are profiled
+         * @param sample_every Time one in this many calls of each thread; see profile::LatencyRecorder
+         */
+        explicit ProfiledFunctor(const FunctorPlugin_T<T>& inner, const std::uint32_t sample_every = 1) :
+            FunctorPlugin_T<T>(inner.get_name(), inner.get_version()), m_inner(inner), m_recorder(sample_every),
+            m_batch_recorder(sample_every) {}
+
+        /**
+         * @brief Forward the call to the wrapped plugin and record its latency
+         *
+         * While a trace is running (see profile::Tracer), the call is also traced as a span.
+         */
+        T operator()(const T& input) const override {
+            profile::TraceSpan span("plugin", "call", this->get_name());
+            profile::ScopedLatency timer(m_recorder);
+            return m_inner(input);
+        }
+
+        /**
+         * @brief Forward a consuming call to the wrapped plugin and record its latency
+         */
+        T operator()(T&& input) const override {
+            profile::TraceSpan span("plugin", "call", this->get_name());
+            profile::ScopedLatency timer(m_recorder);
+            return m_inner(std::move(input));
+        }
+
+        /**
+         * @brief Forward an in-place call to the wrapped plugin and record its latency
+         *
+         * Recorded with the single calls; see latency().
+         */
+        void transform(T& value) const override {
+            profile::TraceSpan span("plugin", "transform", this->get_name());
+            profile::ScopedLatency timer(m_recorder);
+            m_inner.transform(value);
+        }
+
+        /**
+         * @brief Forward a batch to the wrapped plugin and record the latency of the whole batch
+         *
+         * Batches are recorded separately from single calls; see batch_latency().
+         */
+        void apply(const std::span<const T> in, const std::span<T> out) const override {
+            profile::TraceSpan span("plugin", "apply", this->get_name());
+            profile::ScopedLatency timer(m_batch_recorder);
+            m_inner.apply(in, out);
+        }
+
+        /**
+         * @brief Report the wrapped plugin's concurrency trait; recording itself is thread-safe
+         */
+        [[nodiscard]] Concurrency concurrency() const noexcept override { return m_inner.concurrency(); }
+
+        /**
+         * @brief Merge the latency histograms recorded so far by every thread
+         */
+        [[nodiscard]] profile::LatencyHistogram latency() const { return m_recorder.snapshot(); }
+
+        /**
+         * @brief Merge the latency histograms of apply() batches recorded so far by every thread
+         */
+        [[nodiscard]] profile::LatencyHistogram batch_latency() const { return m_batch_recorder.snapshot(); }
+
+        /**
+         * @brief Get the wrapped plugin
+         */
+        [[nodiscard]] const FunctorPlugin_T<T>& inner() const noexcept { return m_inner; }
+
+    private:
+        const FunctorPlugin_T<T>& m_inner;
+        mutable profile::LatencyRecorder m_recorder;
+        mutable profile::LatencyRecorder m_batch_recorder;
+    };
+}
@@ -0,0 +1,100 @@
+/**
+ * @file thread_pool.h
+ * @brief Minimal fixed-size thread pool used by the plugin manager
+ *
+ * The pool runs fire-and-forget tasks on a fixed set of worker threads and
+ * offers a blocking parallel_for for fork/join style work such as running
+ * plugin factories for a batch of libraries concurrently.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <latch>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace fourdst::plugin::utils {
+
+    /**
+     * @brief Fixed-size pool of worker threads executing queued tasks in FIFO order
+     *
+     * @note Tasks must not throw; an exception escaping a task terminates the process
+     * @note The destructor runs every task that is still queued before joining the workers
+     *
+     * Example usage:
+     * @code
+     * fourdst::plugin::utils::ThreadPool pool(4);
+     * std::vector<int> squares(100);
+     * pool.parallel_for(squares.size(), [&](std::size_t i) { squares[i] = i * i; });
+     * @endcode
+     */
+    class ThreadPool {
+    public:
+        /**
+         * @brief Start a pool with the given number of worker threads
+         *
+         * @param thread_count Number of workers; 0 selects std::thread::hardware_concurrency()
+         */
+        explicit ThreadPool(std::size_t thread_count = 0);
+
+        /**
+         * @brief Drain the queue and join all workers
+         */
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+        ThreadPool(ThreadPool&&) = delete;
+        ThreadPool& operator=(ThreadPool&&) = delete;
+
+        /**
+         * @brief Queue a task for execution on one of the workers
+         *
+         * @param task The task to run; must not throw
+         */
+        void submit(std::function<void()> task);
+
+        /**
+         * @brief Run fn(i) for every i in [0, count) on the pool and wait for all of them
+         *
+         * @param count Number of iterations
+         * @param fn Callable invoked with each index; must not throw
+         *
+         * @note Must not be called from one of this pool's own workers
+         */
+        template<typename Fn>
+        void parallel_for(const std::size_t count, Fn&& fn) {
+            if (count == 0) {
+                return;
+            }
+            std::latch done(static_cast<std::ptrdiff_t>(count));
+            for (std::size_t i = 0; i < count; ++i) {
+                submit([&fn, &done, i] {
+                    fn(i);
+                    done.count_down();
+                });
+            }
+            done.wait();
+        }
+
+        /**
+         * @brief Number of worker threads in the pool
+         */
+        [[nodiscard]] std::size_t size() const noexcept { return m_workers.size(); }
+
+    private:
+        void run();
+
+        std::mutex m_mutex;
+        std::condition_variable m_cv;
+        std::deque<std::function<void()>> m_tasks;
+        bool m_stopping = false;
+        std::vector<std::thread> m_workers;
+    };
+
+}
@@ -1,16 +1,19 @@
 #include "fourdst/plugin/bundle/bundle.h"
 #include "fourdst/plugin/manager/plugin_manager.h"
 #include "fourdst/plugin/factory/plugin_factory.h"
+#include "fourdst/plugin/profile/trace.h"
 
 #include "fourdst/crypt/public_key.h"
 #include "fourdst/crypt/crypt_verification.h"
 #include "fourdst/crypt/openSSL_utils.h"
+#include "utils/json.h"
 
 #include "mz.h"
 #include "mz_zip.h"
 #include "mz_strm.h"
 #include "mz_strm_os.h" // For file stream operations
 
+#include <chrono>
 #include <string>
 #include <vector>
 #include <filesystem>
@@ -46,6 +49,28 @@ namespace {
 
         throw std::runtime_error("Unable to determine home directory (are you running on a POSIX compliant system?)!");
     }
+    /**
+     * @brief Adds the lifetime of the timer to a phase duration.
+     */
+    class PhaseTimer {
+    public:
+        explicit PhaseTimer(std::chrono::nanoseconds& phase) : m_phase(phase) {}
+        ~PhaseTimer() { m_phase += std::chrono::steady_clock::now() - m_start; }
+
+        PhaseTimer(const PhaseTimer&) = delete;
+        PhaseTimer& operator=(const PhaseTimer&) = delete;
+
+    private:
+        std::chrono::nanoseconds& m_phase;
+        std::chrono::steady_clock::time_point m_start = std::chrono::steady_clock::now();
+    };
+
+    void append_duration(std::string& out, const char* key, const std::chrono::nanoseconds duration) {
+        out += ", \"";
+        out += key;
+        out += "_ns\": " + std::to_string(duration.count());
+    }
+
     void check_mz_error(int32_t err, const std::string& msg) {
         if (err != MZ_OK) {
             std::ostringstream os;
@@ -313,6 +338,7 @@ namespace {
 
 namespace fourdst::plugin::bundle {
     bool PluginBundle::verify_bundle() {
+        profile::TraceSpan span("bundle", "verify_bundle");
         m_trusted = false;
         m_signed = false;
         auto signatureSection = m_bundleManifest["bundleSignature"];
@@ -335,12 +361,19 @@ namespace fourdst::plugin::bundle {
 
             if (m_bundleAuthorKeyFingerprint && !m_bundleSignature->empty()) {
                 try {
-                    std::string data_to_verify_str = reconstruct_and_verify(
-                        m_temporaryDirectory.get_path(),
-                        m_bundleManifest
-                    );
+                    std::string data_to_verify_str;
+                    {
+                        PhaseTimer timer(m_loadStats.checksum);
+                        profile::TraceSpan span("bundle", "reconstruct_and_verify");
+                        data_to_verify_str = reconstruct_and_verify(
+                            m_temporaryDirectory.get_path(),
+                            m_bundleManifest
+                        );
+                    }
                     const std::vector<unsigned char> data_to_verify_vec(data_to_verify_str.begin(), data_to_verify_str.end());
 
+                    PhaseTimer timer(m_loadStats.signature);
+
                     auto trusted_keys_expectation = get_host_trusted_keys();
                     if (!trusted_keys_expectation) {
                         throw std::runtime_error("Trusted keys directory does not exist or no trusted keys found.");
@@ -388,13 +421,17 @@ namespace fourdst::plugin::bundle {
     }
 
     std::vector<PluginPlatforms> PluginBundle::parse_manifest(const std::filesystem::path& manifestPath) {
-        m_bundleManifest = YAML::LoadFile(manifestPath.string());
+        profile::TraceSpan span("bundle", "parse_manifest");
+        {
+            PhaseTimer timer(m_loadStats.manifest);
+            m_bundleManifest = YAML::LoadFile(manifestPath.string());
 
-        m_bundleName = m_bundleManifest["bundleName"].as<std::string>();
-        m_bundleVersion = m_bundleManifest["bundleVersion"].as<std::string>();
-        m_bundleAuthor = m_bundleManifest["bundleAuthor"].as<std::string>();
-        m_bundleComment = m_bundleManifest["bundleComment"].as<std::string>();
-        m_bundledDatetime = m_bundleManifest["bundledOn"].as<std::string>();
+            m_bundleName = m_bundleManifest["bundleName"].as<std::string>();
+            m_bundleVersion = m_bundleManifest["bundleVersion"].as<std::string>();
+            m_bundleAuthor = m_bundleManifest["bundleAuthor"].as<std::string>();
+            m_bundleComment = m_bundleManifest["bundleComment"].as<std::string>();
+            m_bundledDatetime = m_bundleManifest["bundledOn"].as<std::string>();
+        }
 
         if (const bool trusted = verify_bundle(); !trusted) {
             throw std::runtime_error("Bundle verification failed or bundle is not trusted.");
@@ -404,6 +441,7 @@ namespace fourdst::plugin::bundle {
             throw std::runtime_error("Bundle manifest does not contain 'bundlePlugins' section.");
         }
 
+        std::optional<PhaseTimer> timer(std::in_place, m_loadStats.manifest);
         std::vector<PluginPlatforms> bundledPlugins;
         size_t total_plugins_arch_independent = 0;
         for (const auto& plugin_node : m_bundleManifest["bundlePlugins"]) {
@@ -450,6 +488,7 @@ namespace fourdst::plugin::bundle {
             }
         }
 
+        timer.emplace(m_loadStats.abi_filter);
         auto HostABISignature = parse_abi_signature(m_hostABISignature);
         if (!HostABISignature) {
             throw std::runtime_error("Failed to parse host ABI signature: " + m_hostABISignature);
@@ -490,14 +529,21 @@ namespace fourdst::plugin::bundle {
         return goodPlugins;
     }
 
-    PluginBundle::PluginBundle(const std::filesystem::path &filename, const PluginLoadPolicy policy) :
-    m_loadPolicy(policy), m_pluginManager(manager::PluginManager::getInstance()) {
+    PluginBundle::PluginBundle(const std::filesystem::path &filename, manager::PluginManager &manager, const PluginLoadPolicy policy) :
+    m_loadPolicy(policy), m_pluginManager(manager) {
+        PhaseTimer total(m_loadStats.total);
+        const std::string bundle_name = filename.filename().string();
+        profile::TraceSpan span("bundle", "PluginBundle", bundle_name);
+        m_loadStats.path = filename;
         if (!std::filesystem::exists(filename)) {
             throw std::runtime_error("Plugin bundle file does not exist: " + filename.string());
         }
         m_filepath = filename;
 
-        unpackBundle(filename, m_temporaryDirectory);
+        {
+            PhaseTimer timer(m_loadStats.unzip);
+            unpackBundle(filename, m_temporaryDirectory);
+        }
 
         build_host_metadata();
 
@@ -509,7 +555,12 @@ namespace fourdst::plugin::bundle {
         m_trusted = false;
         m_signed = false;
         const std::vector<PluginPlatforms> good_plugins = parse_manifest(manifestPath);
-        load(good_plugins);
+        {
+            PhaseTimer timer(m_loadStats.load);
+            profile::TraceSpan load_span("bundle", "load");
+            load(good_plugins);
+        }
+        m_loadStats.plugins = m_pluginNames;
 
     }
 
@@ -545,6 +596,33 @@ namespace fourdst::plugin::bundle {
         return m_signed;
     }
 
+    const BundleLoadStats& PluginBundle::getLoadStats() const {
+        return m_loadStats;
+    }
+
+    std::string to_json(const BundleLoadStats& stats) {
+        std::string out = "{\"path\": ";
+        detail::append_json_string(out, stats.path.string());
+        append_duration(out, "unzip", stats.unzip);
+        append_duration(out, "manifest", stats.manifest);
+        append_duration(out, "checksum", stats.checksum);
+        append_duration(out, "signature", stats.signature);
+        append_duration(out, "abi_filter", stats.abi_filter);
+        append_duration(out, "load", stats.load);
+        append_duration(out, "total", stats.total);
+        out += ", \"plugins\": [";
+        for (std::size_t i = 0; i < stats.plugins.size(); ++i) {
+            if (i) {
+                out += ", ";
+            }
+            detail::append_json_string(out, stats.plugins[i]);
+        }
+        out += "]}\n";
+        return out;
+    }
+
+
+    PluginBundle::PluginBundle(const std::filesystem::path &filename, const PluginLoadPolicy policy) : PluginBundle(filename, manager::PluginManager::getInstance(), policy) {}
 
     PluginBundle::PluginBundle(const std::filesystem::path &filename) :  PluginBundle(filename, PluginLoadPolicy::ALL_PLUGINS_ABI_COMPATIBLE) {}
 
@@ -563,6 +641,7 @@ namespace fourdst::plugin::bundle {
     }
 
     void PluginBundle::unpackBundle(const std::filesystem::path& archivePath, const utils::TemporaryDirectory &temporaryDirectory) {
+        profile::TraceSpan span("bundle", "unpackBundle");
         const std::filesystem::path tempDirectoryPath = temporaryDirectory.get_path();
         unzip_archive(archivePath, tempDirectoryPath);
     }
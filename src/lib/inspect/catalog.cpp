@@ -0,0 +1,202 @@
+#include "fourdst/plugin/inspect/catalog.h"
+#include "fourdst/plugin/utils/thread_pool.h"
+
+#include <algorithm>
+#include <charconv>
+#include <fstream>
+#include <map>
+#include <string>
+#include <system_error>
+#include <thread>
+
+namespace {
+    /**
+     * @brief First line of an index file; bumped whenever the format changes.
+     *
+     * Every further line describes one library as tab-separated fields:
+     * file name, size, mtime ticks, plugin name, version, note ABI version and
+     * comma-separated interface IDs. Libraries without a note have an empty name.
+     */
+    constexpr std::string_view kIndexHeader = "fourdst-plugin-catalog 1";
+
+#if defined(__APPLE__)
+    constexpr std::string_view kLibraryExtension = ".dylib";
+#elif defined(_WIN32)
+    constexpr std::string_view kLibraryExtension = ".dll";
+#else
+    constexpr std::string_view kLibraryExtension = ".so";
+#endif
+
+    using Index = std::map<std::string, fourdst::plugin::CatalogEntry, std::less<>>;
+
+    /**
+     * @brief Split off the next tab-separated field of line.
+     */
+    std::string_view next_field(std::string_view& line) {
+        const std::size_t tab = line.find('\t');
+        const std::string_view field = line.substr(0, tab);
+        line = tab == std::string_view::npos ? std::string_view{} : line.substr(tab + 1);
+        return field;
+    }
+
+    template<typename Int>
+    bool parse_int(const std::string_view text, Int& value) {
+        const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+        return error == std::errc{} && end == text.data() + text.size();
+    }
+
+    bool parse_line(std::string_view line, const std::filesystem::path& directory, std::string& file, fourdst::plugin::CatalogEntry& entry) {
+        file = next_field(line);
+        std::int64_t mtime = 0;
+        std::uint32_t abi_version = 0;
+        if (file.empty() || !parse_int(next_field(line), entry.size) || !parse_int(next_field(line), mtime)) {
+            return false;
+        }
+        entry.path = directory / file;
+        entry.mtime = std::filesystem::file_time_type(std::filesystem::file_time_type::duration(mtime));
+
+        const std::string_view name = next_field(line);
+        const std::string_view version = next_field(line);
+        const std::string_view abi = next_field(line);
+        std::string_view ids = next_field(line);
+        if (name.empty()) {
+            return true;
+        }
+        if (!parse_int(abi, abi_version)) {
+            return false;
+        }
+
+        fourdst::plugin::PluginMetadata metadata{std::string(name), std::string(version), {}, abi_version};
+        while (!ids.empty()) {
+            const std::size_t comma = ids.find(',');
+            fourdst::plugin::interface_id_t id = 0;
+            if (!parse_int(ids.substr(0, comma), id)) {
+                return false;
+            }
+            metadata.interface_ids.push_back(id);
+            ids = comma == std::string_view::npos ? std::string_view{} : ids.substr(comma + 1);
+        }
+        entry.metadata = std::move(metadata);
+        return true;
+    }
+
+    /**
+     * @brief Read the index, keyed by file name. A missing or unrecognised index yields an empty one.
+     */
+    Index read_index(const std::filesystem::path& cache_file, const std::filesystem::path& directory) {
+        Index index;
+        std::ifstream in(cache_file);
+        std::string line;
+        if (!in || !std::getline(in, line) || line != kIndexHeader) {
+            return index;
+        }
+        std::string file;
+        while (std::getline(in, line)) {
+            fourdst::plugin::CatalogEntry entry;
+            if (!parse_line(line, directory, file, entry)) {
+                return {}; // Corrupt: rebuild from scratch
+            }
+            index.emplace(std::move(file), std::move(entry));
+        }
+        return index;
+    }
+
+    bool is_storable(const std::string_view text) {
+        return text.find_first_of("\t\n\r") == std::string_view::npos;
+    }
+
+    /**
+     * @brief Write the index next to its final location and rename it into place.
+     *
+     * Libraries whose file name or metadata cannot be represented are left out and
+     * simply get inspected again by the next scan.
+     */
+    void write_index(const std::filesystem::path& cache_file, const std::vector<fourdst::plugin::CatalogEntry>& entries) {
+        std::string out(kIndexHeader);
+        out += '\n';
+        for (const auto& entry : entries) {
+            const std::string file = entry.path.filename().string();
+            if (!is_storable(file) || (entry.metadata && (entry.metadata->name.empty() ||
+                !is_storable(entry.metadata->name) || !is_storable(entry.metadata->version)))) {
+                continue;
+            }
+            out += file;
+            out += '\t' + std::to_string(entry.size);
+            out += '\t' + std::to_string(static_cast<std::int64_t>(entry.mtime.time_since_epoch().count()));
+            if (entry.metadata) {
+                out += '\t' + entry.metadata->name + '\t' + entry.metadata->version;
+                out += '\t' + std::to_string(entry.metadata->abi_version) + '\t';
+                for (std::size_t i = 0; i < entry.metadata->interface_ids.size(); ++i) {
+                    out += (i ? "," : "") + std::to_string(entry.metadata->interface_ids[i]);
+                }
+            }
+            out += '\n';
+        }
+
+        std::filesystem::path temporary = cache_file;
+        temporary += ".tmp";
+        {
+            std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+            file.write(out.data(), static_cast<std::streamsize>(out.size()));
+            if (!file) {
+                return;
+            }
+        }
+        std::error_code ignored;
+        std::filesystem::rename(temporary, cache_file, ignored);
+        if (ignored) {
+            std::filesystem::remove(temporary, ignored);
+        }
+    }
+}
+
+namespace fourdst::plugin {
+
+    PluginCatalog scan_directory(const std::filesystem::path& directory, const std::filesystem::path& cache_file) {
+        const std::filesystem::path index_path = cache_file.empty() ? directory / kCatalogFileName : cache_file;
+        Index index = read_index(index_path, directory);
+
+        PluginCatalog catalog;
+        std::vector<std::size_t> stale;
+        for (const auto& file : std::filesystem::directory_iterator(directory)) {
+            std::error_code error;
+            if (!file.is_regular_file(error) || file.path().extension() != kLibraryExtension) {
+                continue;
+            }
+            CatalogEntry entry;
+            entry.path = file.path();
+            entry.size = file.file_size(error);
+            if (!error) {
+                entry.mtime = file.last_write_time(error);
+            }
+            if (error) {
+                continue; // Vanished while scanning
+            }
+
+            const auto cached = index.find(entry.path.filename().string());
+            if (cached != index.end() && cached->second.size == entry.size && cached->second.mtime == entry.mtime) {
+                entry.metadata = std::move(cached->second.metadata);
+                ++catalog.cached;
+            } else {
+                stale.push_back(catalog.entries.size());
+            }
+            catalog.entries.push_back(std::move(entry));
+        }
+
+        if (!stale.empty()) {
+            utils::ThreadPool pool(std::min<std::size_t>(stale.size(), std::max(1u, std::thread::hardware_concurrency())));
+            pool.parallel_for(stale.size(), [&](const std::size_t i) {
+                CatalogEntry& entry = catalog.entries[stale[i]];
+                entry.metadata = inspect(entry.path);
+            });
+            catalog.inspected = stale.size();
+        }
+
+        std::ranges::sort(catalog.entries, {}, &CatalogEntry::path);
+        if (!stale.empty() || catalog.cached != index.size()) {
+            write_index(index_path, catalog.entries);
+        }
+        return catalog;
+    }
+
+}
@@ -0,0 +1,184 @@
+#include "fourdst/plugin/inspect/inspect.h"
+#include "fourdst/plugin/inspect/plugin_note.h"
+
+#include <bit>
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+
+#if defined(__linux__)
+#include <elf.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+#if defined(__linux__)
+    /**
+     * @brief Read-only private mapping of a whole file, unmapped on destruction.
+     */
+    class MappedFile {
+    public:
+        explicit MappedFile(const std::filesystem::path& path) noexcept {
+            const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0) {
+                return;
+            }
+            struct stat st{};
+            if (::fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+                void* data = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+                if (data != MAP_FAILED) {
+                    m_data = static_cast<const unsigned char*>(data);
+                    m_size = static_cast<std::size_t>(st.st_size);
+                }
+            }
+            ::close(fd);
+        }
+
+        ~MappedFile() {
+            if (m_data) {
+                ::munmap(const_cast<unsigned char*>(m_data), m_size);
+            }
+        }
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        [[nodiscard]] const unsigned char* data() const noexcept { return m_data; }
+        [[nodiscard]] std::size_t size() const noexcept { return m_size; }
+
+        /**
+         * @brief Whether [offset, offset + length) lies within the file.
+         */
+        [[nodiscard]] bool contains(const std::uint64_t offset, const std::uint64_t length) const noexcept {
+            return offset <= m_size && length <= m_size - offset;
+        }
+
+    private:
+        const unsigned char* m_data = nullptr;
+        std::size_t m_size = 0;
+    };
+
+    template<typename T>
+    T read_at(const unsigned char* data, const std::uint64_t offset) noexcept {
+        T value;
+        std::memcpy(&value, data + offset, sizeof(T));
+        return value;
+    }
+
+    constexpr std::uint64_t align4(const std::uint64_t size) noexcept {
+        return (size + 3) & ~std::uint64_t{3};
+    }
+
+    /**
+     * @brief Decode a note descriptor written by make_plugin_note.
+     */
+    std::optional<fourdst::plugin::PluginMetadata> parse_descriptor(const unsigned char* desc, const std::uint64_t size) {
+        using fourdst::plugin::interface_id_t;
+        namespace note = fourdst::plugin::note;
+
+        if (size < note::kPluginNoteDescHeaderSize) {
+            return std::nullopt;
+        }
+        const auto abi_version = read_at<std::uint32_t>(desc, 0);
+        const auto name_size = read_at<std::uint32_t>(desc, 4);
+        const auto version_size = read_at<std::uint32_t>(desc, 8);
+        const auto interface_count = read_at<std::uint32_t>(desc, 12);
+        if (abi_version != note::kPluginNoteAbiVersion || name_size == 0 || version_size == 0) {
+            return std::nullopt;
+        }
+
+        const std::uint64_t ids_offset = note::kPluginNoteDescHeaderSize;
+        const std::uint64_t name_offset = ids_offset + std::uint64_t{interface_count} * sizeof(interface_id_t);
+        const std::uint64_t version_offset = name_offset + name_size;
+        if (version_offset + version_size > size ||
+            desc[name_offset + name_size - 1] != '\0' || desc[version_offset + version_size - 1] != '\0') {
+            return std::nullopt;
+        }
+
+        fourdst::plugin::PluginMetadata metadata;
+        metadata.abi_version = abi_version;
+        metadata.name.assign(reinterpret_cast<const char*>(desc + name_offset), name_size - 1);
+        metadata.version.assign(reinterpret_cast<const char*>(desc + version_offset), version_size - 1);
+        metadata.interface_ids.reserve(interface_count);
+        for (std::uint32_t i = 0; i < interface_count; ++i) {
+            metadata.interface_ids.push_back(read_at<interface_id_t>(desc, ids_offset + i * sizeof(interface_id_t)));
+        }
+        return metadata;
+    }
+
+    /**
+     * @brief Walk the notes of one section and decode the first plugin note.
+     */
+    std::optional<fourdst::plugin::PluginMetadata> parse_notes(const unsigned char* notes, const std::uint64_t size) {
+        namespace note = fourdst::plugin::note;
+        constexpr std::string_view owner(note::kPluginNoteOwner, sizeof(note::kPluginNoteOwner));
+
+        std::uint64_t offset = 0;
+        while (offset + sizeof(Elf64_Nhdr) <= size) {
+            const auto header = read_at<Elf64_Nhdr>(notes, offset);
+            const std::uint64_t name_offset = offset + sizeof(Elf64_Nhdr);
+            const std::uint64_t desc_offset = name_offset + align4(header.n_namesz);
+            const std::uint64_t next = desc_offset + align4(header.n_descsz);
+            if (next > size) {
+                return std::nullopt;
+            }
+            if (header.n_type == note::kPluginNoteType &&
+                std::string_view(reinterpret_cast<const char*>(notes + name_offset), header.n_namesz) == owner) {
+                return parse_descriptor(notes + desc_offset, header.n_descsz);
+            }
+            offset = next;
+        }
+        return std::nullopt;
+    }
+#endif
+}
+
+namespace fourdst::plugin {
+
+    std::optional<PluginMetadata> inspect(const std::filesystem::path& library_path) {
+#if defined(__linux__)
+        const MappedFile file(library_path);
+        const unsigned char* data = file.data();
+        if (!data || !file.contains(0, sizeof(Elf64_Ehdr))) {
+            return std::nullopt;
+        }
+
+        const auto ehdr = read_at<Elf64_Ehdr>(data, 0);
+        constexpr unsigned char host_data = std::endian::native == std::endian::little ? ELFDATA2LSB : ELFDATA2MSB;
+        if (std::memcmp(ehdr.e_ident, ELFMAG, SELFMAG) != 0 || ehdr.e_ident[EI_CLASS] != ELFCLASS64 ||
+            ehdr.e_ident[EI_DATA] != host_data || ehdr.e_shentsize != sizeof(Elf64_Shdr) ||
+            !file.contains(ehdr.e_shoff, std::uint64_t{ehdr.e_shnum} * sizeof(Elf64_Shdr)) || ehdr.e_shstrndx >= ehdr.e_shnum) {
+            return std::nullopt;
+        }
+
+        const auto section = [&](const std::uint64_t index) {
+            return read_at<Elf64_Shdr>(data, ehdr.e_shoff + index * sizeof(Elf64_Shdr));
+        };
+        const Elf64_Shdr names = section(ehdr.e_shstrndx);
+        if (!file.contains(names.sh_offset, names.sh_size)) {
+            return std::nullopt;
+        }
+        const std::string_view wanted(note::kPluginNoteSection);
+
+        for (std::uint64_t i = 0; i < ehdr.e_shnum; ++i) {
+            const Elf64_Shdr shdr = section(i);
+            if (shdr.sh_type != SHT_NOTE || shdr.sh_name >= names.sh_size || !file.contains(shdr.sh_offset, shdr.sh_size)) {
+                continue;
+            }
+            const auto* name = reinterpret_cast<const char*>(data + names.sh_offset + shdr.sh_name);
+            if (std::string_view(name, ::strnlen(name, names.sh_size - shdr.sh_name)) != wanted) {
+                continue;
+            }
+            return parse_notes(data + shdr.sh_offset, shdr.sh_size);
+        }
+        return std::nullopt;
+#else
+        (void)library_path;
+        return std::nullopt;
+#endif
+    }
+
+}
@@ -0,0 +1,42 @@
+#include "fourdst/plugin/manager/load_stats.h"
+#include "utils/json.h"
+
+namespace {
+    void append_field(std::string& out, const char* key, const std::chrono::nanoseconds duration) {
+        out += ", \"";
+        out += key;
+        out += "_ns\": ";
+        out += std::to_string(duration.count());
+    }
+}
+
+namespace fourdst::plugin::manager {
+
+    std::string to_json(const LoadStats& stats) {
+        std::string out = "{\"plugins\": [";
+        for (std::size_t i = 0; i < stats.plugins.size(); ++i) {
+            const PluginLoadStats& plugin = stats.plugins[i];
+            out += i ? ",\n  {" : "\n  {";
+            out += "\"path\": ";
+            detail::append_json_string(out, plugin.path.string());
+            out += ", \"name\": ";
+            detail::append_json_string(out, plugin.name);
+            out += plugin.loaded ? ", \"loaded\": true" : ", \"loaded\": false";
+            out += ", \"error\": ";
+            detail::append_json_string(out, plugin.error);
+            append_field(out, "inspect", plugin.inspect);
+            append_field(out, "stat", plugin.stat);
+            append_field(out, "dlopen", plugin.dlopen);
+            append_field(out, "symbols", plugin.symbols);
+            append_field(out, "create", plugin.create);
+            append_field(out, "name_check", plugin.name_check);
+            append_field(out, "total", plugin.total);
+            out += ", \"rss_delta\": " + std::to_string(plugin.rss_delta);
+            out += ", \"mapped_size\": " + std::to_string(plugin.mapped_size);
+            out += '}';
+        }
+        out += stats.plugins.empty() ? "]}\n" : "\n]}\n";
+        return out;
+    }
+
+}
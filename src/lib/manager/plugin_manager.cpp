@@ -1,12 +1,376 @@
 #include "fourdst/plugin/manager/plugin_manager.h"
 #include "fourdst/plugin/factory/plugin_factory.h"
+#include "fourdst/plugin/inspect/inspect.h"
+#include "fourdst/plugin/utils/thread_pool.h"
+#include "fourdst/plugin/profile/trace.h"
 
 #include <dlfcn.h>
+#include <fcntl.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <link.h>
+#endif
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <expected>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <new>
+#include <optional>
 #include <ranges>
+#include <shared_mutex>
+#include <stop_token>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
+namespace {
+    /**
+     * @brief Hash that lets string-keyed maps be probed with a std::string_view.
+     */
+    struct StringHash {
+        using is_transparent = void;
+        std::size_t operator()(const std::string_view text) const noexcept { return std::hash<std::string_view>{}(text); }
+    };
+
+    /**
+     * @brief Per-thread reader state for an epoch domain.
+     *
+     * A slot holds the domain's epoch observed when its thread entered its
+     * outermost read-side section, or zero while the thread is quiescent.
+     * Slots are padded to a cache line so that readers never share a line.
+     */
+    struct alignas(64) ReaderSlot {
+        std::atomic<std::uint64_t> epoch{0};
+        std::uint32_t depth = 0;
+        std::atomic<bool> abandoned{false}; ///< Set when the owning thread exits
+    };
+
+    /**
+     * @brief Epoch domain used to reclaim the registry snapshots of one manager.
+     *
+     * Readers publish the epoch they entered in and never block or take a lock
+     * (apart from a one-time slot registration per thread and domain). Writers
+     * publish a new snapshot, advance the epoch and wait until every reader that
+     * could still observe the old snapshot has left its read-side section. Every
+     * manager has its own domain, so readers of one manager never hold up the
+     * writers of another.
+     */
+    class EpochDomain {
+    public:
+        EpochDomain() = default;
+        EpochDomain(const EpochDomain&) = delete;
+        EpochDomain& operator=(const EpochDomain&) = delete;
+
+        /**
+         * @brief Enter a read-side section.
+         *
+         * @throws std::bad_alloc If this is the thread's first section in the domain and its slot cannot be allocated
+         */
+        void enter() {
+            ReaderSlot& slot = local_slot();
+            if (slot.depth++ == 0) {
+                // Pairs with the seq_cst slot loads in passed(): see there
+                slot.epoch.store(m_epoch.load(std::memory_order_acquire), std::memory_order_seq_cst);
+            }
+            ++t_depth;
+        }
+
+        void exit() noexcept {
+            ReaderSlot& slot = *find_slot();
+            if (--slot.depth == 0) {
+                slot.epoch.store(0, std::memory_order_release);
+            }
+            --t_depth;
+        }
+
+        /**
+         * @brief Whether the calling thread is inside a read-side section of this domain.
+         */
+        [[nodiscard]] bool in_read_section() const noexcept {
+            const ReaderSlot* slot = find_slot();
+            return slot && slot->depth > 0;
+        }
+
+        /**
+         * @brief Whether the calling thread is inside a read-side section of any domain.
+         *
+         * Such a thread must not wait for readers in any domain: a thread waiting
+         * for it in turn would deadlock.
+         */
+        [[nodiscard]] static bool in_any_read_section() noexcept {
+            return t_depth > 0;
+        }
+
+        /**
+         * @brief Start a new epoch after unpublishing data.
+         *
+         * @return The epoch every reader must have reached (or left its section) before
+         *         the unpublished data can be reclaimed
+         */
+        std::uint64_t advance() noexcept {
+            return m_epoch.fetch_add(1, std::memory_order_seq_cst) + 1;
+        }
+
+        /**
+         * @brief Whether no reader can still hold a reference to data unpublished before target was returned.
+         *
+         * A single pass over the reader slots; never waits.
+         *
+         * The check is a store-buffer pattern: a reader stores its slot's epoch and
+         * then loads the registry, a writer exchanges the registry and then loads
+         * the slots. All four accesses are seq_cst, so in their single total order
+         * either the reader's load sees the new snapshot or the writer's load sees
+         * the reader's epoch. Weaker slot loads (acquire) would allow both to miss.
+         */
+        [[nodiscard]] bool passed(const std::uint64_t target) {
+            std::lock_guard lock(m_slots_mutex);
+            std::erase_if(m_slots, [](const auto& slot) { return slot->abandoned.load(std::memory_order_acquire); });
+            for (const auto& slot : m_slots) {
+                const std::uint64_t observed = slot->epoch.load(std::memory_order_seq_cst);
+                if (observed != 0 && observed < target) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /**
+         * @brief Wait until passed(target) holds.
+         *
+         * @pre The calling thread is not inside a read-side section of any domain.
+         */
+        void wait_until_passed(const std::uint64_t target) {
+            while (!passed(target)) {
+                std::this_thread::yield();
+            }
+        }
+
+    private:
+        /**
+         * @brief The slots of one thread, one per domain it has read from; abandoned when the thread exits.
+         */
+        struct ThreadSlots {
+            std::vector<std::pair<std::uint64_t, std::shared_ptr<ReaderSlot>>> slots;
+
+            ~ThreadSlots() {
+                for (const auto& slot : slots | std::views::values) {
+                    slot->abandoned.store(true, std::memory_order_release);
+                }
+            }
+        };
+
+        [[nodiscard]] ReaderSlot* find_slot() const noexcept {
+            if (t_cached_domain == m_id) [[likely]] {
+                return t_cached_slot;
+            }
+            for (const auto& [domain, slot] : t_slots.slots) {
+                if (domain == m_id) {
+                    t_cached_domain = m_id;
+                    t_cached_slot = slot.get();
+                    return t_cached_slot;
+                }
+            }
+            return nullptr;
+        }
+
+        ReaderSlot& local_slot() {
+            if (ReaderSlot* slot = find_slot()) [[likely]] {
+                return *slot;
+            }
+            // Forget the slots of domains destroyed since, which hold no other reference to them
+            std::erase_if(t_slots.slots, [](const auto& entry) { return entry.second.use_count() == 1; });
+
+            auto slot = std::make_shared<ReaderSlot>();
+            {
+                std::lock_guard lock(m_slots_mutex);
+                m_slots.push_back(slot);
+            }
+            t_slots.slots.emplace_back(m_id, slot);
+            t_cached_domain = m_id;
+            t_cached_slot = slot.get();
+            return *slot;
+        }
+
+        static inline std::atomic<std::uint64_t> s_next_id{1};
+
+        const std::uint64_t m_id = s_next_id.fetch_add(1, std::memory_order_relaxed); ///< Never reused, unlike addresses
+        std::atomic<std::uint64_t> m_epoch{1};
+        std::mutex m_slots_mutex;
+        std::vector<std::shared_ptr<ReaderSlot>> m_slots;
+
+        static inline thread_local ThreadSlots t_slots;
+        static inline thread_local std::uint64_t t_cached_domain = 0; ///< Domain of t_cached_slot
+        static inline thread_local ReaderSlot* t_cached_slot = nullptr;
+        static inline thread_local std::uint32_t t_depth = 0; ///< Read-side sections entered, over all domains
+    };
+
+    /**
+     * @brief A thread's own instance of a plugin, created by PluginManager::get_local.
+     */
+    struct LocalInstance {
+        std::shared_ptr<fourdst::plugin::IPlugin> instance;
+        const std::atomic<std::uint64_t>* generation_cell = nullptr; ///< Only read while its manager is alive
+        std::uint64_t generation = 0;
+        bool indexed = false; ///< See PluginManager::RawPlugin
+    };
+
+    /**
+     * @brief The instances one thread made from one manager.
+     */
+    struct LocalInstances {
+        std::weak_ptr<void> manager; ///< Expires when the manager is destroyed
+        std::unordered_map<std::string, LocalInstance> instances;
+    };
+
+    /**
+     * @brief Per-thread instances: manager ID -> instances; destroyed when the thread exits.
+     *
+     * Keyed by an ID rather than the manager's address so that a new manager
+     * never picks up the instances of a destroyed one. The entries of destroyed
+     * managers are purged by the thread's next get_local call.
+     */
+    thread_local std::unordered_map<std::uint64_t, LocalInstances> t_local_instances;
+    thread_local std::uint64_t t_seen_destroyed_managers = 0; ///< g_destroyed_managers at this thread's last purge
+
+    std::atomic<std::uint64_t> g_next_manager_id{1};
+    std::atomic<std::uint64_t> g_destroyed_managers{0}; ///< Bumped by every manager destructor
+
+    /**
+     * @brief Ask the kernel to start reading a library into the page cache.
+     *
+     * Best effort only: any failure is ignored and resurfaces when the library is opened.
+     */
+    void prefetch_library(const std::filesystem::path& library_path) noexcept {
+        const int fd = ::open(library_path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return;
+        }
+#if defined(__linux__)
+        ::posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+#endif
+        ::close(fd);
+    }
+
+    /**
+     * @brief Resident set size of the process in bytes, or 0 where it cannot be read.
+     */
+    std::int64_t resident_bytes() noexcept {
+#if defined(__linux__)
+        const int fd = ::open("/proc/self/statm", O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return 0;
+        }
+        char buffer[128];
+        const ssize_t length = ::read(fd, buffer, sizeof(buffer) - 1);
+        ::close(fd);
+        if (length <= 0) {
+            return 0;
+        }
+        buffer[length] = '\0';
+        long long total_pages = 0;
+        long long resident_pages = 0;
+        if (std::sscanf(buffer, "%lld %lld", &total_pages, &resident_pages) != 2) {
+            return 0;
+        }
+        return resident_pages * ::sysconf(_SC_PAGESIZE);
+#else
+        return 0;
+#endif
+    }
+
+    /**
+     * @brief Bytes spanned by the loadable segments of an open library, or 0 where unknown.
+     */
+    std::uint64_t mapped_size(void* handle) noexcept {
+#if defined(__GLIBC__)
+        link_map* map = nullptr;
+        if (dlinfo(handle, RTLD_DI_LINKMAP, &map) != 0 || !map) {
+            return 0;
+        }
+        struct Search {
+            const link_map* map;
+            std::uint64_t size = 0;
+        } search{map};
+        dl_iterate_phdr([](dl_phdr_info* info, std::size_t, void* data) -> int {
+            auto& target = *static_cast<Search*>(data);
+            if (info->dlpi_addr != target.map->l_addr || !info->dlpi_name || std::strcmp(info->dlpi_name, target.map->l_name) != 0) {
+                return 0;
+            }
+            for (int i = 0; i < info->dlpi_phnum; ++i) {
+                if (info->dlpi_phdr[i].p_type == PT_LOAD) {
+                    target.size += info->dlpi_phdr[i].p_memsz;
+                }
+            }
+            return 1;
+        }, &search);
+        return search.size;
+#else
+        (void)handle;
+        return 0;
+#endif
+    }
+
+    std::string describe(const std::exception_ptr& error) {
+        try {
+            std::rethrow_exception(error);
+        } catch (const std::exception& e) {
+            return e.what();
+        } catch (...) {
+            return "unknown error";
+        }
+    }
+
+    /**
+     * @brief The PluginErrorCode of an exception thrown by a load or lookup.
+     */
+    fourdst::plugin::exception::PluginErrorCode error_code(const std::exception_ptr& error) noexcept {
+        using fourdst::plugin::exception::PluginErrorCode;
+        try {
+            std::rethrow_exception(error);
+        } catch (const fourdst::plugin::exception::PluginNotLoadedError&) {
+            return PluginErrorCode::NotLoaded;
+        } catch (const fourdst::plugin::exception::PluginTypeError&) {
+            return PluginErrorCode::TypeMismatch;
+        } catch (const fourdst::plugin::exception::PluginSymbolError&) {
+            return PluginErrorCode::MissingSymbol;
+        } catch (const fourdst::plugin::exception::PluginNameCollisionError&) {
+            return PluginErrorCode::NameCollision;
+        } catch (const std::bad_alloc&) {
+            return PluginErrorCode::ResourceExhausted;
+        } catch (const std::system_error&) {
+            return PluginErrorCode::ResourceExhausted;
+        } catch (...) {
+            return PluginErrorCode::LoadFailed; // PluginLoadError, or whatever the plugin's constructor threw
+        }
+    }
+
+    /**
+     * @brief RAII read-side critical section on an epoch domain.
+     */
+    class ReadSection {
+    public:
+        explicit ReadSection(EpochDomain& domain) : m_domain(domain) { m_domain.enter(); }
+        ~ReadSection() { m_domain.exit(); }
+        ReadSection(const ReadSection&) = delete;
+        ReadSection& operator=(const ReadSection&) = delete;
+
+    private:
+        EpochDomain& m_domain;
+    };
+}
+
 namespace fourdst::plugin {
 
     struct PluginDeleter {
@@ -19,29 +383,1014 @@ namespace fourdst::plugin {
     };
 
     struct manager::PluginManager::Impl {
-        struct PluginHandle {
+        /**
+         * @brief A dlmopen link-map namespace, alive while any library loaded into it is.
+         */
+        struct LinkNamespace {
+            long id = 0;             ///< The namespace's Lmid_t
+            std::shared_ptr<std::mutex> guard; ///< Impl::namespace_mutex, held while libraries enter or leave
+        };
+
+        static void close_library(void* handle, std::shared_ptr<LinkNamespace> link_namespace) noexcept {
+            if (link_namespace) {
+                // Closing the last library destroys the namespace; it must not be joined meanwhile
+                std::lock_guard lock(*link_namespace->guard);
+                dlclose(handle);
+                link_namespace.reset();
+            } else {
+                dlclose(handle);
+            }
+        }
+
+        /**
+         * @brief Closes the libraries of one manager, either on the releasing thread or on a reaper thread.
+         *
+         * Shared by the manager and every library it opened, so that libraries
+         * outliving the manager are closed the same way. The reaper thread is
+         * started by the first deferred close and drains its queue before the
+         * closer is destroyed.
+         */
+        struct LibraryCloser {
+            struct Pending {
+                void* handle;
+                std::shared_ptr<LinkNamespace> link_namespace;
+            };
+
+            std::atomic<bool> deferred{false}; ///< Hand libraries to the reaper (set_deferred_unload)
+            std::atomic<bool> leak{false};     ///< Leave libraries mapped (fast_shutdown)
+
+            std::mutex mutex;
+            std::condition_variable_any wake;
+            std::condition_variable idle;
+            std::deque<Pending> queue; ///< Guarded by mutex
+            bool closing = false;      ///< The reaper is inside dlclose; guarded by mutex
+            std::jthread reaper;       ///< Guarded by mutex; declared last so that it is joined first
+
+            void close(void* handle, std::shared_ptr<LinkNamespace> link_namespace) noexcept {
+                if (leak.load(std::memory_order_relaxed)) {
+                    return;
+                }
+                if (deferred.load(std::memory_order_relaxed)) {
+                    try {
+                        std::lock_guard lock(mutex);
+                        if (!reaper.joinable()) {
+                            reaper = std::jthread([this](const std::stop_token& stop) { run(stop); });
+                        }
+                        queue.push_back(Pending{handle, link_namespace});
+                        wake.notify_one();
+                        return;
+                    } catch (...) {
+                        // No memory or no thread: close it here instead
+                    }
+                }
+                close_library(handle, std::move(link_namespace));
+            }
+
+            void run(const std::stop_token& stop) {
+                std::unique_lock lock(mutex);
+                // Returns false only once stop is requested and the queue is empty
+                while (wake.wait(lock, stop, [this] { return !queue.empty(); })) {
+                    Pending next = std::move(queue.front());
+                    queue.pop_front();
+                    closing = true;
+                    lock.unlock();
+                    if (!leak.load(std::memory_order_relaxed)) {
+                        profile::TraceSpan span("manager", "dlclose");
+                        close_library(next.handle, std::move(next.link_namespace));
+                    }
+                    next.link_namespace.reset();
+                    lock.lock();
+                    closing = false;
+                    if (queue.empty()) {
+                        idle.notify_all();
+                    }
+                }
+            }
+
+            void drop_pending() {
+                std::lock_guard lock(mutex);
+                queue.clear();
+                if (!closing) {
+                    idle.notify_all();
+                }
+            }
+
+            void flush() {
+                std::unique_lock lock(mutex);
+                idle.wait(lock, [this] { return queue.empty() && !closing; });
+            }
+        };
+
+        /**
+         * @brief An open plugin library, closed with the last record or instance created from it.
+         *
+         * Instances made with create_instance() may outlive the record (and the
+         * manager), so they share ownership of the library they were created from.
+         */
+        struct Library {
+            void* handle = nullptr;
+            std::shared_ptr<LinkNamespace> link_namespace; ///< Set for libraries opened with a namespace group
+            std::shared_ptr<LibraryCloser> closer; ///< The opening manager's closer
+            plugin_creator_t creator = nullptr;
+            plugin_destroyer_t destroyer = nullptr;
+            plugin_warmup_t warmer = nullptr; ///< Optional warmup_plugin export
+
+            ~Library() {
+                if (handle) {
+                    closer->close(handle, std::move(link_namespace));
+                }
+            }
+        };
+
+        struct PluginRecord {
+            std::string name;
             std::unique_ptr<IPlugin, PluginDeleter> instance = {nullptr, {nullptr}};
-            void* library_handle = nullptr;
+            std::shared_ptr<Library> library;
+            const std::atomic<std::uint64_t>* generation_cell = nullptr; ///< Interned per-name generation counter
+            std::uint64_t generation = 0; ///< Value of *generation_cell when this record was loaded
+            std::vector<interface_id_t> interface_ids; ///< Interfaces reported by get_plugin_interfaces
+            bool indexed = false; ///< Whether the library reported its interfaces at all
+            bool lazy = false; ///< Loaded on first access through register_lazy, and thus evictable
+            bool warm = false; ///< Warm-up has already run, so add() does not schedule it
+            mutable std::shared_mutex symbols_mutex;
+            mutable std::unordered_map<std::string, void*, StringHash, std::equal_to<>> symbols; ///< dlsym results, misses as nullptr; guarded by symbols_mutex
+            std::atomic<std::int64_t> last_access{0}; ///< steady_clock ticks of the last lookup; only kept for lazy records
+
+            void touch() noexcept {
+                last_access.store(std::chrono::steady_clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+            }
+
+            /**
+             * @brief Look up an exported symbol of the library, through the cache.
+             */
+            void* symbol(const std::string_view symbol_name) const {
+                {
+                    std::shared_lock lock(symbols_mutex);
+                    if (const auto it = symbols.find(symbol_name); it != symbols.end()) {
+                        return it->second;
+                    }
+                }
+                std::string key(symbol_name);
+                void* resolved = dlsym(library->handle, key.c_str());
+                std::lock_guard lock(symbols_mutex);
+                return symbols.try_emplace(std::move(key), resolved).first->second;
+            }
+
+            ~PluginRecord() {
+                // The plugin's destructor lives in the library, so it must run before dlclose
+                instance.reset();
+                library.reset();
+            }
+        };
+
+        /**
+         * @brief A plugin registered with register_lazy; shared by every snapshot until unloaded.
+         */
+        struct LazyEntry {
+            std::string name;
+            std::filesystem::path path;
+            LoadOptions options;
+            std::mutex init_mutex; ///< Serializes first-access loading of this plugin
+        };
+
+        static std::shared_ptr<LazyEntry> make_lazy(const std::filesystem::path& library_path, const std::string& plugin_name, const LoadOptions& options) {
+            auto entry = std::make_shared<LazyEntry>();
+            entry->name = plugin_name;
+            entry->path = library_path;
+            entry->options = options;
+            return entry;
+        }
+
+        using InterfaceList = std::shared_ptr<const std::vector<void*>>;
+
+        /**
+         * @brief Immutable snapshot of the loaded plugins.
+         *
+         * Snapshots are never modified once published. Writers copy the current
+         * snapshot, apply their change and swap the copy in; records and interface
+         * lists are shared between consecutive snapshots and die with the last one
+         * referencing them.
+         */
+        struct Registry {
+            std::map<std::string, std::shared_ptr<PluginRecord>> plugins;
+            std::map<interface_id_t, InterfaceList> interfaces; ///< Interface ID -> implementing plugins, already converted
+            std::vector<IPlugin*> unindexed; ///< Plugins that did not report their interfaces
+            std::map<std::string, std::shared_ptr<LazyEntry>> lazy; ///< Registrations, loaded or not; plugins takes precedence
+
+            [[nodiscard]] bool claims(const std::string& name) const {
+                return plugins.contains(name) || lazy.contains(name);
+            }
+
+            void index(const PluginRecord& record) {
+                IPlugin* plugin = record.instance.get();
+                if (!record.indexed) {
+                    unindexed.push_back(plugin);
+                    return;
+                }
+                for (const interface_id_t id : record.interface_ids) {
+                    void* interface = plugin->query_interface(id);
+                    if (!interface) {
+                        continue;
+                    }
+                    InterfaceList& list = interfaces[id];
+                    auto extended = list ? std::make_shared<std::vector<void*>>(*list) : std::make_shared<std::vector<void*>>();
+                    extended->push_back(interface);
+                    list = std::move(extended);
+                }
+            }
+
+            void unindex(const PluginRecord& record) {
+                IPlugin* plugin = record.instance.get();
+                if (!record.indexed) {
+                    std::erase(unindexed, plugin);
+                    return;
+                }
+                for (const interface_id_t id : record.interface_ids) {
+                    const auto it = interfaces.find(id);
+                    if (it == interfaces.end()) {
+                        continue;
+                    }
+                    auto reduced = std::make_shared<std::vector<void*>>(*it->second);
+                    std::erase(*reduced, plugin->query_interface(id));
+                    if (reduced->empty()) {
+                        interfaces.erase(it);
+                    } else {
+                        it->second = std::move(reduced);
+                    }
+                }
+            }
+        };
+
+        const std::uint64_t id = g_next_manager_id.fetch_add(1, std::memory_order_relaxed); ///< Never reused; keys t_local_instances
+        std::shared_ptr<void> lifetime = std::make_shared<char>(); ///< Reset on destruction; watched by t_local_instances
+        EpochDomain domain; ///< Readers and reclamation of this manager's snapshots
+        std::atomic<const Registry*> registry{new Registry()};
+        std::mutex writer_mutex; ///< Serializes load/unload; never taken by readers
+
+        /**
+         * @brief Generation counters, interned per plugin name for the lifetime of the manager.
+         *
+         * A counter is bumped whenever a plugin with that name is loaded or unloaded,
+         * which is what lets a PluginHandle detect that it has gone stale.
+         */
+        std::map<std::string, std::unique_ptr<std::atomic<std::uint64_t>>, std::less<>> generations;
+
+        std::shared_ptr<std::mutex> namespace_mutex = std::make_shared<std::mutex>(); ///< Serializes creating, joining and leaving link-map namespaces
+        std::map<std::string, std::weak_ptr<LinkNamespace>> namespaces; ///< Namespace group -> live namespace
+
+        /**
+         * @brief A replaced snapshot waiting for its readers to leave.
+         */
+        struct Retired {
+            std::unique_ptr<const Registry> snapshot;
+            std::uint64_t target = 0; ///< Epoch readers must pass before snapshot can be freed
+        };
+
+        std::mutex retired_mutex;
+        std::vector<Retired> retired; ///< Ordered by target
+        std::atomic<std::size_t> retired_count{0}; ///< retired.size(), readable without the lock
+
+        std::shared_ptr<LibraryCloser> closer = std::make_shared<LibraryCloser>();
+
+        std::mutex warm_mutex;
+        std::condition_variable warm_cv;
+        std::unique_ptr<utils::ThreadPool> warm_pool; ///< Created with the first plugin that has a warm-up; guarded by warm_mutex
+        std::size_t warming = 0; ///< Warm-ups queued or running; guarded by warm_mutex
+        bool warm_stopping = false; ///< Set by the destructor; queued warm-ups are skipped; guarded by warm_mutex
+        std::vector<WarmupFailure> warm_failures; ///< Guarded by warm_mutex
+
+        std::mutex eviction_mutex; ///< Serializes reconfiguration of the idle-eviction thread
+        std::condition_variable_any eviction_cv;
+        std::jthread evictor;
+
+        ~Impl() {
+            retired.clear();
+            delete registry.load(std::memory_order_acquire);
+        }
+
+        /**
+         * @pre writer_mutex is held by the caller.
+         */
+        std::atomic<std::uint64_t>& generation_cell(const std::string& plugin_name) {
+            auto& cell = generations[plugin_name];
+            if (!cell) {
+                cell = std::make_unique<std::atomic<std::uint64_t>>(0);
+            }
+            return *cell;
+        }
+
+        static int dlopen_flags(const LoadOptions& options, [[maybe_unused]] const std::filesystem::path& library_path) {
+            int flags = options.binding == LoadOptions::Binding::Now ? RTLD_NOW : RTLD_LAZY;
+            flags |= options.scope == LoadOptions::Scope::Global ? RTLD_GLOBAL : RTLD_LOCAL;
+            if (options.deep_bind) {
+#if defined(RTLD_DEEPBIND)
+                flags |= RTLD_DEEPBIND;
+#else
+                throw exception::PluginLoadError("Cannot load '" + library_path.string() + "': RTLD_DEEPBIND is not supported on this platform.");
+#endif
+            }
+            return flags;
+        }
+
+        /**
+         * @brief dlmopen a library into its group's namespace, creating the namespace if needed.
+         *
+         * @return The library handle, or nullptr with the reason available from dlerror()
+         */
+        void* open_in_namespace(const std::filesystem::path& library_path, int flags, const std::string& group,
+                                std::shared_ptr<LinkNamespace>& link_namespace) {
+#if defined(__GLIBC__)
+            flags &= ~RTLD_GLOBAL; // glibc refuses RTLD_GLOBAL for a new namespace
+            std::lock_guard lock(*namespace_mutex);
+            std::weak_ptr<LinkNamespace>& slot = namespaces[group];
+            link_namespace = slot.lock();
+            void* handle = dlmopen(link_namespace ? link_namespace->id : LM_ID_NEWLM, library_path.c_str(), flags);
+            if (handle && !link_namespace) {
+                Lmid_t id = 0;
+                if (dlinfo(handle, RTLD_DI_LMID, &id) != 0) {
+                    dlclose(handle);
+                    return nullptr;
+                }
+                link_namespace = std::make_shared<LinkNamespace>(LinkNamespace{id, namespace_mutex});
+                slot = link_namespace;
+            }
+            return handle;
+#else
+            (void)flags;
+            (void)group;
+            (void)link_namespace;
+            throw exception::PluginLoadError("Cannot load '" + library_path.string() + "': dlmopen namespaces are not supported on this platform.");
+#endif
+        }
+
+        std::atomic<bool> stats_enabled{false};
+        std::mutex stats_mutex;
+        LoadStats stats; ///< Guarded by stats_mutex
+
+        /**
+         * @brief Times the phases of one plugin load and records them when it is done.
+         *
+         * Time between phases that is spent on other plugins (in load_all) or on
+         * measuring memory is not attributed to any phase.
+         */
+        class LoadProbe {
+        public:
+            LoadProbe(Impl& impl, const std::filesystem::path& library_path) :
+                m_impl(impl), m_memory(impl.stats_enabled.load(std::memory_order_relaxed)) {
+                m_stats.path = library_path;
+            }
+
+            /**
+             * @brief Attribute the time since the previous lap to phase.
+             */
+            void lap(std::chrono::nanoseconds PluginLoadStats::* phase,
+                     const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now()) noexcept {
+                const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(now - m_last);
+                m_stats.*phase += elapsed;
+                m_stats.total += elapsed;
+                m_last = now;
+            }
+
+            /**
+             * @brief Start timing the next phase now, discarding the time since the previous lap.
+             */
+            void resume() noexcept { m_last = std::chrono::steady_clock::now(); }
+
+            /**
+             * @brief Attribute the time from start to end to phase, for work shared with other plugins.
+             */
+            void charge(std::chrono::nanoseconds PluginLoadStats::* phase,
+                        const std::chrono::steady_clock::time_point start, const std::chrono::steady_clock::time_point end) noexcept {
+                m_last = start;
+                lap(phase, end);
+            }
+
+            /**
+             * @brief Note the resident set size before the library is opened.
+             */
+            void library_opening() noexcept {
+                if (m_memory) {
+                    m_rss_before = resident_bytes();
+                    resume();
+                }
+            }
+
+            /**
+             * @brief Measure the memory taken by a library that has just been opened.
+             */
+            void library_opened(void* handle) noexcept {
+                if (m_memory) {
+                    m_stats.rss_delta = resident_bytes() - m_rss_before;
+                    m_stats.mapped_size = mapped_size(handle);
+                    resume();
+                }
+            }
+
+            void succeeded(const std::string& plugin_name) {
+                m_stats.name = plugin_name;
+                m_stats.loaded = true;
+                commit();
+            }
+
+            void failed(const std::exception_ptr& error, const std::string& plugin_name = {}) {
+                m_stats.name = plugin_name;
+                m_stats.error = describe(error);
+                commit();
+            }
+
+        private:
+            void commit() {
+                if (m_impl.stats_enabled.load(std::memory_order_relaxed)) {
+                    std::lock_guard lock(m_impl.stats_mutex);
+                    m_impl.stats.plugins.push_back(std::move(m_stats));
+                }
+            }
+
+            Impl& m_impl;
+            bool m_memory;
+            PluginLoadStats m_stats;
+            std::chrono::steady_clock::time_point m_last = std::chrono::steady_clock::now();
+            std::int64_t m_rss_before = 0;
+        };
+
+        /**
+         * @brief Open a plugin library and resolve its entry points.
+         *
+         * @return A record owning the library handle, without a plugin instance yet
+         */
+        std::shared_ptr<PluginRecord> open_library(const std::filesystem::path& library_path, const LoadOptions& options, LoadProbe& probe) {
+            if (!std::filesystem::exists(library_path)) {
+                throw exception::PluginLoadError("Plugin library not found at path: " + library_path.string());
+            }
+            probe.lap(&PluginLoadStats::stat);
+
+            probe.library_opening();
+            const int flags = dlopen_flags(options, library_path);
+            std::shared_ptr<LinkNamespace> link_namespace;
+            void* handle = options.namespace_group.empty()
+                ? dlopen(library_path.c_str(), flags)
+                : open_in_namespace(library_path, flags, options.namespace_group, link_namespace);
+            if (!handle) {
+                throw exception::PluginLoadError("Failed to load library '" + library_path.string() + "'. Error: " + dlerror());
+            }
+            probe.lap(&PluginLoadStats::dlopen);
+
+            auto library = std::make_shared<Library>();
+            library->handle = handle;
+            library->link_namespace = std::move(link_namespace);
+            library->closer = closer;
+            library->creator = reinterpret_cast<plugin_creator_t>(dlsym(handle, "create_plugin"));
+            library->destroyer = reinterpret_cast<plugin_destroyer_t>(dlsym(handle, "destroy_plugin"));
+
+            if (!library->creator || !library->destroyer) {
+                throw exception::PluginSymbolError("Could not find 'create_plugin' or 'destroy_plugin' in library '" + library_path.string() + "'.");
+            }
+            library->warmer = reinterpret_cast<plugin_warmup_t>(dlsym(handle, "warmup_plugin")); // Optional
+            auto record = std::make_shared<PluginRecord>();
+            record->instance = { nullptr, {library->destroyer} };
+            for (const std::string& symbol_name : options.required_symbols) {
+                void* symbol = dlsym(handle, symbol_name.c_str());
+                if (!symbol) {
+                    throw exception::PluginSymbolError("Could not find required symbol '" + symbol_name + "' in library '" + library_path.string() + "'.");
+                }
+                record->symbols.emplace(symbol_name, symbol);
+            }
+            record->library = std::move(library);
+
+            // Optional: libraries built before interface IDs existed lack both the list and the
+            // query_interface()/concurrency() vtable slots; they are only ever reached through dynamic_cast
+            if (const auto interfaces = reinterpret_cast<plugin_interfaces_t>(dlsym(handle, "get_plugin_interfaces"))) {
+                std::size_t count = 0;
+                const interface_id_t* ids = interfaces(&count);
+                record->interface_ids.assign(ids, ids + count);
+                record->indexed = true;
+            }
+            probe.lap(&PluginLoadStats::symbols);
+            probe.library_opened(handle);
+            return record;
+        }
+
+        /**
+         * @brief Run the library's plugin factory and record the plugin's self-reported name.
+         */
+        static void instantiate(PluginRecord& record, const std::filesystem::path& library_path, LoadProbe& probe) {
+            IPlugin* raw_instance = record.library->creator();
+            if (!raw_instance) {
+                throw exception::PluginLoadError("Plugin factory in '" + library_path.string() + "' returned a nullptr.");
+            }
+            record.instance.reset(raw_instance);
+            record.name = raw_instance->get_name();
+            probe.lap(&PluginLoadStats::create);
+        }
+
+        /**
+         * @brief Reject a library whose metadata note names an already claimed plugin, before it is opened.
+         *
+         * Libraries without a note are let through; their name is checked once the plugin exists.
+         */
+        void reject_known_collision(const std::optional<PluginMetadata>& metadata) {
+            if (!metadata) {
+                return;
+            }
+            ReadSection section(domain);
+            if (registry.load(std::memory_order_seq_cst)->claims(metadata->name)) {
+                throw exception::PluginNameCollisionError("A plugin with the name '" + metadata->name + "' is already loaded.");
+            }
+        }
+
+        /**
+         * @brief Add a fully loaded plugin to a (not yet published) snapshot.
+         *
+         * @pre writer_mutex is held by the caller and next does not contain the plugin's name.
+         */
+        void add(Registry& next, std::shared_ptr<PluginRecord> record) {
+            auto& generation = generation_cell(record->name);
+            record->generation_cell = &generation;
+            record->generation = generation.fetch_add(1, std::memory_order_acq_rel) + 1;
+
+            next.index(*record);
+            if (record->library->warmer && !record->warm) {
+                schedule_warmup(record);
+            }
+            std::string name = record->name;
+            next.plugins.emplace(std::move(name), std::move(record));
+        }
+
+        /**
+         * @brief Run a plugin's warm-up on the warm-up pool.
+         *
+         * The task keeps the record alive, so a plugin unloaded meanwhile is
+         * destroyed once its warm-up has finished.
+         */
+        void schedule_warmup(std::shared_ptr<PluginRecord> record) {
+            record->warm = true;
+            std::lock_guard lock(warm_mutex);
+            if (warm_stopping) {
+                return;
+            }
+            if (!warm_pool) {
+                warm_pool = std::make_unique<utils::ThreadPool>();
+            }
+            ++warming;
+            warm_pool->submit([this, record = std::move(record)]() mutable {
+                bool skip;
+                {
+                    std::lock_guard state(warm_mutex);
+                    skip = warm_stopping;
+                }
+                if (!skip) {
+                    profile::TraceSpan span("manager", "warmup", record->name);
+                    try {
+                        record->library->warmer(record->instance.get());
+                    } catch (...) {
+                        const std::exception_ptr error = std::current_exception();
+                        std::lock_guard state(warm_mutex);
+                        warm_failures.push_back({record->name, describe(error), error});
+                    }
+                }
+                record.reset(); // Possibly the last reference: destroy the plugin before reporting
+                {
+                    std::lock_guard state(warm_mutex);
+                    --warming;
+                }
+                warm_cv.notify_all();
+            });
+        }
+
+        /**
+         * @brief Skip every queued warm-up and wait for the running ones.
+         */
+        void stop_warmups() {
+            std::unique_ptr<utils::ThreadPool> pool;
+            {
+                std::lock_guard lock(warm_mutex);
+                warm_stopping = true;
+                pool = std::move(warm_pool);
+            }
+            pool.reset();
+        }
+
+        /**
+         * @brief Remove a loaded plugin from a (not yet published) snapshot and invalidate its handles.
+         *
+         * @pre writer_mutex is held by the caller and next contains the plugin.
+         */
+        void remove(Registry& next, const std::string& plugin_name) {
+            const auto it = next.plugins.find(plugin_name);
+            // Invalidate outstanding handles before the plugin can be destroyed
+            generation_cell(plugin_name).fetch_add(1, std::memory_order_acq_rel);
+            next.unindex(*it->second);
+            next.plugins.erase(it);
+        }
+
+        /**
+         * @brief Look a plugin up, loading it first if it is registered lazily and not loaded yet.
+         *
+         * @throw Whatever load() throws if the lazily registered plugin fails to load
+         */
+        ResolvedPlugin find(const std::string& plugin_name) {
+            return visit(plugin_name, [](const PluginRecord& record) {
+                return ResolvedPlugin{record.instance.get(), record.generation_cell, record.generation, record.indexed};
+            }).value_or(ResolvedPlugin{});
+        }
+
+        /**
+         * @brief Look up an exported symbol of a loaded plugin's library.
+         *
+         * @return The symbol (nullptr if not exported), or std::nullopt if no plugin with that name is loaded or registered
+         * @throw Whatever load() throws if a lazily registered plugin fails to load
+         */
+        std::optional<void*> symbol(const std::string& plugin_name, const std::string_view symbol_name) {
+            return visit(plugin_name, [symbol_name](const PluginRecord& record) { return record.symbol(symbol_name); });
+        }
+
+        /**
+         * @brief Look up a function table exported by a loaded plugin.
+         *
+         * @return The table (nullptr if the plugin offers none with that ID and size), or
+         *         std::nullopt if no plugin with that name is loaded or registered
+         * @throw Whatever load() throws if a lazily registered plugin fails to load
+         */
+        std::optional<const void*> function_table(const std::string& plugin_name, const interface_id_t table_id, const std::size_t min_size) {
+            return visit(plugin_name, [table_id, min_size](const PluginRecord& record) -> const void* {
+                const auto lookup = reinterpret_cast<plugin_function_table_t>(record.symbol("get_plugin_function_table"));
+                if (!lookup) {
+                    return nullptr;
+                }
+                std::size_t size = 0;
+                const void* table = lookup(table_id, &size);
+                return size >= min_size ? table : nullptr;
+            });
+        }
+
+        /**
+         * @brief Create a new instance of a loaded plugin that shares ownership of its library.
+         *
+         * @throw exception::PluginNotLoadedError If no plugin with that name is loaded or registered
+         * @throw exception::PluginLoadError If the plugin factory returns a nullptr
+         */
+        SpawnedPlugin spawn(const std::string& plugin_name) {
+            struct Source {
+                std::shared_ptr<Library> library;
+                const std::atomic<std::uint64_t>* generation_cell;
+                std::uint64_t generation;
+                bool indexed;
+            };
+            auto source = visit(plugin_name, [](const PluginRecord& record) {
+                return Source{record.library, record.generation_cell, record.generation, record.indexed};
+            });
+            if (!source) {
+                throw exception::PluginNotLoadedError(plugin_name + " has not been loaded or does not exist (have you called manager.load()?)");
+            }
+
+            IPlugin* raw_instance = source->library->creator();
+            if (!raw_instance) {
+                throw exception::PluginLoadError("Plugin factory of '" + plugin_name + "' returned a nullptr.");
+            }
+            // The deleter keeps the library open for as long as the instance lives
+            std::shared_ptr<IPlugin> instance(raw_instance, [library = source->library](IPlugin* p) {
+                library->destroyer(p);
+            });
+            return {std::move(instance), source->generation_cell, source->generation, source->indexed};
+        }
+
+        /**
+         * @brief Run visitor on the record of a plugin inside a read section, loading a lazily registered plugin first.
+         *
+         * @return The visitor's result, or std::nullopt if no plugin with that name is loaded or registered
+         * @throw Whatever load() throws if the lazily registered plugin fails to load
+         */
+        template<typename Visitor>
+        std::optional<std::invoke_result_t<Visitor&, const PluginRecord&>> visit(const std::string& plugin_name, Visitor&& visitor) {
+            while (true) {
+                std::shared_ptr<LazyEntry> pending;
+                {
+                    ReadSection section(domain);
+                    const Registry& current = *registry.load(std::memory_order_seq_cst);
+                    if (const auto it = current.plugins.find(plugin_name); it != current.plugins.end()) {
+                        PluginRecord& record = *it->second;
+                        if (record.lazy) {
+                            record.touch();
+                        }
+                        return visitor(std::as_const(record));
+                    }
+                    const auto it = current.lazy.find(plugin_name);
+                    if (it == current.lazy.end()) {
+                        return std::nullopt;
+                    }
+                    pending = it->second;
+                }
+                // Leave the read section first so the snapshot replaced by loading can be freed right away
+                if (!materialize(*pending)) {
+                    return std::nullopt;
+                }
+            }
+        }
+
+        /**
+         * @brief Load a lazily registered plugin unless another thread already has.
+         *
+         * @return false if the registration was removed in the meantime
+         */
+        bool materialize(LazyEntry& entry) {
+            std::unique_lock init(entry.init_mutex);
+            profile::TraceSpan span("manager", "lazy_load", entry.name);
+            {
+                ReadSection section(domain);
+                const Registry& current = *registry.load(std::memory_order_seq_cst);
+                if (!current.lazy.contains(entry.name)) {
+                    return false;
+                }
+                if (current.plugins.contains(entry.name)) {
+                    return true;
+                }
+            }
+
+            LoadProbe probe(*this, entry.path);
+            try {
+                auto record = open_library(entry.path, entry.options, probe);
+                instantiate(*record, entry.path, probe);
+                if (record->name != entry.name) {
+                    throw exception::PluginLoadError("Plugin in '" + entry.path.string() + "' reports the name '" + record->name +
+                                                     "' but was registered as '" + entry.name + "'.");
+                }
+                record->lazy = true;
+                record->touch();
+
+                std::uint64_t target = 0;
+                {
+                    Writer writer(*this);
+                    const Registry& current = writer.current();
+                    if (const auto it = current.lazy.find(entry.name); it == current.lazy.end() || it->second.get() != &entry) {
+                        return false;
+                    }
+                    auto next = std::make_unique<Registry>(current);
+                    add(*next, std::move(record));
+                    writer.publish(std::move(next));
+                    target = writer.release_target();
+                }
+                probe.lap(&PluginLoadStats::name_check);
+                probe.succeeded(entry.name);
+                // A pinned thread may be waiting for init_mutex, so never wait for readers while holding it
+                init.unlock();
+                reclaim(target);
+                return true;
+            } catch (...) {
+                probe.failed(std::current_exception(), entry.name);
+                throw;
+            }
+        }
+
+        std::size_t evict_idle(const std::chrono::steady_clock::duration idle_for) {
+            const std::int64_t cutoff = (std::chrono::steady_clock::now() - idle_for).time_since_epoch().count();
+
+            Writer writer(*this);
+            const Registry& current = writer.current();
+            std::vector<std::string> idle;
+            for (const auto& [name, record] : current.plugins) {
+                if (record->lazy && record->last_access.load(std::memory_order_relaxed) <= cutoff) {
+                    idle.push_back(name);
+                }
+            }
+            if (idle.empty()) {
+                return 0;
+            }
+
+            auto next = std::make_unique<Registry>(current);
+            for (const auto& name : idle) {
+                remove(*next, name);
+            }
+            writer.publish(std::move(next));
+            return idle.size();
+        }
+
+        /**
+         * @brief Swap in a new snapshot and retire the previous one.
+         *
+         * @pre writer_mutex is held by the caller.
+         * @return The epoch readers must pass before the retired snapshot can be reclaimed
+         */
+        std::uint64_t retire(std::unique_ptr<const Registry> next) {
+            std::unique_ptr<const Registry> previous(registry.exchange(next.release(), std::memory_order_seq_cst));
+            const std::uint64_t target = domain.advance();
+            std::lock_guard lock(retired_mutex);
+            retired.push_back({std::move(previous), target});
+            retired_count.store(retired.size(), std::memory_order_relaxed);
+            return target;
+        }
+
+        /**
+         * @brief Free every retired snapshot whose target epoch is at most target.
+         *
+         * @pre No reader can still observe those snapshots.
+         */
+        void collect(const std::uint64_t target) {
+            std::vector<Retired> reclaimable;
+            {
+                std::lock_guard lock(retired_mutex);
+                const auto first_kept = std::ranges::find_if(retired, [target](const Retired& r) { return r.target > target; });
+                reclaimable.assign(std::make_move_iterator(retired.begin()), std::make_move_iterator(first_kept));
+                retired.erase(retired.begin(), first_kept);
+                retired_count.store(retired.size(), std::memory_order_relaxed);
+            }
+            // reclaimable is destroyed here, outside the lock: plugin destructors and dlclose run now
+        }
+
+        /**
+         * @brief Wait for the readers of a snapshot retired at target, then free it.
+         *
+         * A thread inside a read section would wait for itself, so it only frees
+         * what is already unreachable and leaves the rest for later.
+         */
+        void reclaim(const std::uint64_t target) {
+            if (EpochDomain::in_any_read_section()) {
+                try_reclaim();
+                return;
+            }
+            domain.wait_until_passed(target);
+            collect(target);
+        }
+
+        /**
+         * @brief Free the retired snapshots that no reader can observe anymore. Never waits.
+         */
+        void try_reclaim() {
+            if (retired_count.load(std::memory_order_relaxed) == 0) {
+                return;
+            }
+            std::vector<std::uint64_t> targets;
+            {
+                std::unique_lock lock(retired_mutex, std::try_to_lock);
+                if (!lock.owns_lock()) {
+                    return;
+                }
+                for (const Retired& r : retired) {
+                    targets.push_back(r.target);
+                }
+            }
+            // Targets increase along the list, and passing an epoch implies passing every earlier one
+            for (const std::uint64_t target : targets | std::views::reverse) {
+                if (domain.passed(target)) {
+                    collect(target);
+                    return;
+                }
+            }
+        }
+
+        /**
+         * @brief Exclusive write access to the registry.
+         *
+         * Holds writer_mutex for its lifetime. A snapshot replaced through publish()
+         * is retired, not freed: once the lock has been released, the writer waits
+         * for the readers that may still observe it and frees it, which unloads any
+         * plugin it was the last reference to. Waiting outside the lock lets a reader
+         * that is itself about to write make progress.
+         */
+        class Writer {
+        public:
+            explicit Writer(Impl& impl) : m_impl(impl), m_lock(impl.writer_mutex) {}
+
+            ~Writer() {
+                m_lock.unlock();
+                if (m_target != 0) {
+                    m_impl.reclaim(m_target);
+                }
+            }
+
+            Writer(const Writer&) = delete;
+            Writer& operator=(const Writer&) = delete;
+
+            [[nodiscard]] const Registry& current() const {
+                return *m_impl.registry.load(std::memory_order_acquire);
+            }
+
+            void publish(std::unique_ptr<const Registry> next) {
+                m_target = m_impl.retire(std::move(next));
+            }
+
+            /**
+             * @brief Hand the reclamation of the published snapshot's predecessor to the caller.
+             *
+             * @return The epoch to pass to reclaim(), or 0 if nothing was published
+             */
+            [[nodiscard]] std::uint64_t release_target() noexcept {
+                return std::exchange(m_target, 0);
+            }
+
+        private:
+            Impl& m_impl;
+            std::unique_lock<std::mutex> m_lock;
+            std::uint64_t m_target = 0;
         };
-        std::map<std::string, PluginHandle> plugins;
+
+        /**
+         * @brief Backend of load() and try_load().
+         *
+         * @return std::string The name of the loaded plugin
+         */
+        std::string load(const std::filesystem::path& library_path, const LoadOptions& options) {
+            const std::string file_name = library_path.filename().string();
+            profile::TraceSpan span("manager", "load", file_name);
+            LoadProbe probe(*this, library_path);
+            std::string plugin_name;
+            try {
+                reject_known_collision(inspect(library_path));
+                probe.lap(&PluginLoadStats::inspect);
+
+                auto plugin = open_library(library_path, options, probe);
+                instantiate(*plugin, library_path, probe);
+                plugin_name = plugin->name;
+
+                {
+                    Writer writer(*this);
+                    const Registry& current = writer.current();
+                    if (current.claims(plugin->name)) {
+                        throw exception::PluginNameCollisionError("A plugin with the name '" + plugin->name + "' is already loaded.");
+                    }
+
+                    auto next = std::make_unique<Registry>(current);
+                    add(*next, std::move(plugin));
+                    writer.publish(std::move(next));
+                }
+                probe.lap(&PluginLoadStats::name_check);
+            } catch (...) {
+                probe.failed(std::current_exception(), plugin_name);
+                throw;
+            }
+            probe.succeeded(plugin_name);
+            return plugin_name;
+        }
+
+        /**
+         * @brief Backend of unload() and try_unload().
+         *
+         * @return bool Whether a plugin or registration with the name existed
+         */
+        bool unload(const std::string& plugin_name) {
+            profile::TraceSpan span("manager", "unload", plugin_name);
+            Writer writer(*this);
+            const Registry& current = writer.current();
+            if (!current.claims(plugin_name)) {
+                return false;
+            }
+
+            auto next = std::make_unique<Registry>(current);
+            next->lazy.erase(plugin_name);
+            if (next->plugins.contains(plugin_name)) {
+                remove(*next, plugin_name);
+            }
+            writer.publish(std::move(next));
+            return true;
+        }
     };
 
     bool manager::PluginManager::has(const std::string &plugin_name) const {
-        if (const auto it = pimpl->plugins.find(plugin_name); it != pimpl->plugins.end()) {
-            return it->second.instance != nullptr;
+        try {
+            return pimpl->find(plugin_name).plugin != nullptr;
+        } catch (const std::exception&) {
+            return false;
         }
-        return false;
     }
 
     manager::PluginManager::PluginManager() : pimpl(std::make_unique<Impl>()) {}
-    manager::PluginManager::~PluginManager() {
-        std::vector<std::string> names_to_unload;
-        for (const auto &key: pimpl->plugins | std::views::keys) {
-            names_to_unload.push_back(key);
+    manager::PluginManager::SpawnedPlugin manager::PluginManager::spawn_raw(const std::string& plugin_name) const {
+        return pimpl->spawn(plugin_name);
+    }
+
+    manager::PluginManager::RawPlugin manager::PluginManager::get_local_raw(const std::string& plugin_name) const {
+        if (const std::uint64_t destroyed = g_destroyed_managers.load(std::memory_order_acquire); destroyed != t_seen_destroyed_managers) [[unlikely]] {
+            // Release the instances, and with them the libraries, of managers destroyed since
+            t_seen_destroyed_managers = destroyed;
+            std::erase_if(t_local_instances, [](const auto& entry) { return entry.second.manager.expired(); });
         }
-        for (const auto& name : names_to_unload) {
-            unload(name);
+        const auto [entry, created] = t_local_instances.try_emplace(pimpl->id);
+        if (created) {
+            entry->second.manager = pimpl->lifetime;
         }
+        auto& instances = entry->second.instances;
+        if (const auto it = instances.find(plugin_name); it != instances.end()) {
+            const LocalInstance& local = it->second;
+            if (local.generation_cell->load(std::memory_order_acquire) == local.generation) {
+                return {local.instance.get(), local.indexed};
+            }
+            instances.erase(it); // Stale: made from a plugin that has since been unloaded or replaced
+        }
+
+        SpawnedPlugin spawned = pimpl->spawn(plugin_name);
+        LocalInstance& local = instances[plugin_name];
+        local = {std::move(spawned.instance), spawned.generation_cell, spawned.generation, spawned.indexed};
+        return {local.instance.get(), local.indexed};
+    }
+
+    manager::PluginManager::~PluginManager() {
+        set_idle_eviction(std::chrono::milliseconds::zero());
+        pimpl->stop_warmups();
+        {
+            Impl::Writer writer(*pimpl);
+            writer.publish(std::make_unique<const Impl::Registry>());
+        }
+        pimpl->lifetime.reset();
+        g_destroyed_managers.fetch_add(1, std::memory_order_release);
     }
 
     manager::PluginManager & manager::PluginManager::getInstance() {
@@ -49,56 +1398,427 @@ namespace fourdst::plugin {
         return instance;
     }
 
-    void manager::PluginManager::load(const std::filesystem::path& library_path) const {
-        if (!std::filesystem::exists(library_path)) {
-            throw exception::PluginLoadError("Plugin library not found at path: " + library_path.string());
+    void manager::PluginManager::load(const std::filesystem::path& library_path, const LoadOptions& options) const {
+        (void)pimpl->load(library_path, options);
+    }
+
+    std::expected<std::string, exception::PluginErrorCode> manager::PluginManager::try_load(const std::filesystem::path& library_path, const LoadOptions& options) const noexcept {
+        try {
+            return pimpl->load(library_path, options);
+        } catch (...) {
+            return std::unexpected(error_code(std::current_exception()));
         }
+    }
+
+    manager::LoadReport manager::PluginManager::load_all(const std::span<const std::filesystem::path> library_paths, const LoadOptions& options) const {
+        LoadReport report;
+        const std::size_t count = library_paths.size();
+        if (count == 0) {
+            return report;
+        }
+        const std::string batch_size = std::to_string(count) + " libraries";
+        profile::TraceSpan span("manager", "load_all", batch_size);
+
+        utils::ThreadPool pool(std::min<std::size_t>(count, std::max(1u, std::thread::hardware_concurrency())));
+        std::vector<std::shared_ptr<Impl::PluginRecord>> plugins(count);
+        std::vector<std::exception_ptr> errors(count);
+        std::vector<std::optional<Impl::LoadProbe>> probes(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            probes[i].emplace(*pimpl, library_paths[i]);
+        }
+
+        // Phase 1: pull the files into the page cache and read their metadata notes concurrently
+        std::vector<std::optional<PluginMetadata>> metadata(count);
+        // Pool tasks must not throw, so every task records its error instead
+        pool.parallel_for(count, [&](const std::size_t i) {
+            try {
+                probes[i]->resume();
+                prefetch_library(library_paths[i]);
+                metadata[i] = inspect(library_paths[i]);
+                probes[i]->lap(&PluginLoadStats::inspect);
+            } catch (...) {
+                errors[i] = std::current_exception();
+            }
+        });
 
-        void* handle = dlopen(library_path.c_str(), RTLD_LAZY | RTLD_GLOBAL);
-        if (!handle) {
-            throw exception::PluginLoadError("Failed to load library '" + library_path.string() + "'. Error: " + dlerror());
+        // Phase 2: dlopen and symbol resolution; the dynamic loader serializes these anyway.
+        // Libraries whose note already names a loaded plugin are never opened. Collisions
+        // within the batch are left to phase 4, so that a library that fails to load never
+        // blocks a later one of the same name.
+        for (std::size_t i = 0; i < count; ++i) {
+            if (errors[i]) {
+                continue;
+            }
+            const std::string file_name = library_paths[i].filename().string();
+            profile::TraceSpan library_span("manager", "open", file_name);
+            try {
+                pimpl->reject_known_collision(metadata[i]);
+                probes[i]->resume();
+                plugins[i] = pimpl->open_library(library_paths[i], options, *probes[i]);
+            } catch (...) {
+                errors[i] = std::current_exception();
+            }
         }
 
-        auto creator = reinterpret_cast<plugin_creator_t>(dlsym(handle, "create_plugin"));
-        auto destroyer = reinterpret_cast<plugin_destroyer_t>(dlsym(handle, "destroy_plugin"));
+        // Phase 3: run the plugin factories concurrently
+        pool.parallel_for(count, [&](const std::size_t i) {
+            if (!plugins[i]) {
+                return;
+            }
+            try {
+                const std::string file_name = library_paths[i].filename().string();
+                profile::TraceSpan library_span("manager", "create", file_name);
+                probes[i]->resume();
+                Impl::instantiate(*plugins[i], library_paths[i], *probes[i]);
+            } catch (...) {
+                errors[i] = std::current_exception();
+                plugins[i].reset();
+            }
+        });
 
-        if (!creator || !destroyer) {
-            dlclose(handle);
-            throw exception::PluginSymbolError("Could not find 'create_plugin' or 'destroy_plugin' in library '" + library_path.string() + "'.");
+        // Phase 4: register everything that survived with a single snapshot update
+        std::vector<std::shared_ptr<Impl::PluginRecord>> rejected;
+        std::vector<std::string> names(count);
+        const auto registration = std::chrono::steady_clock::now();
+        {
+            Impl::Writer writer(*pimpl);
+            auto next = std::make_unique<Impl::Registry>(writer.current());
+            for (std::size_t i = 0; i < count; ++i) {
+                if (!plugins[i]) {
+                    continue;
+                }
+                names[i] = plugins[i]->name;
+                if (next->claims(plugins[i]->name)) {
+                    errors[i] = std::make_exception_ptr(exception::PluginNameCollisionError("A plugin with the name '" + plugins[i]->name + "' is already loaded."));
+                    rejected.push_back(std::move(plugins[i]));
+                    continue;
+                }
+                report.loaded.push_back(plugins[i]->name);
+                pimpl->add(*next, std::move(plugins[i]));
+            }
+            if (!report.loaded.empty()) {
+                writer.publish(std::move(next));
+            }
         }
 
-        IPlugin* raw_instance = creator();
-        if (!raw_instance) {
-            dlclose(handle);
-            throw exception::PluginLoadError("Plugin factory in '" + library_path.string() + "' returned a nullptr.");
+        // The single registry update is shared by the whole batch, and charged to every plugin in it
+        const auto registered = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < count; ++i) {
+            if (errors[i]) {
+                report.failures.push_back({library_paths[i], describe(errors[i]), errors[i]});
+                probes[i]->failed(errors[i], names[i]);
+                continue;
+            }
+            probes[i]->charge(&PluginLoadStats::name_check, registration, registered);
+            probes[i]->succeeded(names[i]);
         }
+        return report;
+    }
 
-        const std::string plugin_name = raw_instance->get_name();
+    manager::PluginManager::ReadGuard::ReadGuard(const PluginManager& manager) : m_manager(&manager) {
+        m_manager->pimpl->domain.enter();
+    }
 
-        if (pimpl->plugins.contains(plugin_name)) {
-            destroyer(raw_instance);
-            dlclose(handle);
-            throw exception::PluginNameCollisionError("A plugin with the name '" + plugin_name + "' is already loaded.");
+    manager::PluginManager::ReadGuard::~ReadGuard() {
+        m_manager->pimpl->domain.exit();
+        if (!m_manager->pimpl->domain.in_read_section()) {
+            // Free what writes made from inside this section had to leave behind
+            m_manager->pimpl->try_reclaim();
+        }
+    }
+
+    manager::PluginManager::ReadGuard manager::PluginManager::pin() const {
+        return ReadGuard(*this);
+    }
+
+    void manager::PluginManager::set_deferred_unload(const bool enabled) const {
+        pimpl->closer->deferred.store(enabled, std::memory_order_relaxed);
+    }
+
+    void manager::PluginManager::flush_unloads() const {
+        pimpl->closer->flush();
+    }
+
+    void manager::PluginManager::fast_shutdown() const {
+        profile::TraceSpan span("manager", "fast_shutdown");
+        set_idle_eviction(std::chrono::milliseconds::zero());
+        pimpl->stop_warmups();
+        pimpl->closer->leak.store(true, std::memory_order_relaxed);
+        pimpl->closer->drop_pending();
+        Impl::Writer writer(*pimpl);
+        writer.publish(std::make_unique<const Impl::Registry>());
+    }
+
+    void manager::PluginManager::wait_until_warm() const {
+        std::unique_lock lock(pimpl->warm_mutex);
+        pimpl->warm_cv.wait(lock, [&] { return pimpl->warming == 0; });
+    }
+
+    bool manager::PluginManager::wait_until_warm(const std::chrono::milliseconds timeout) const {
+        std::unique_lock lock(pimpl->warm_mutex);
+        return pimpl->warm_cv.wait_for(lock, timeout, [&] { return pimpl->warming == 0; });
+    }
+
+    std::vector<manager::WarmupFailure> manager::PluginManager::warmup_failures() const {
+        std::lock_guard lock(pimpl->warm_mutex);
+        return pimpl->warm_failures;
+    }
+
+    void manager::PluginManager::enable_load_stats(const bool enabled) const {
+        pimpl->stats_enabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    manager::LoadStats manager::PluginManager::load_stats() const {
+        std::lock_guard lock(pimpl->stats_mutex);
+        return pimpl->stats;
+    }
+
+    void manager::PluginManager::clear_load_stats() const {
+        std::lock_guard lock(pimpl->stats_mutex);
+        pimpl->stats.plugins.clear();
+    }
+
+    void manager::PluginManager::reload(const std::string& plugin_name, const std::filesystem::path& library_path, const LoadOptions& options) const {
+        profile::TraceSpan span("manager", "reload", plugin_name);
+        const auto not_loaded = [&] {
+            return exception::PluginNotLoadedError(plugin_name + " has not been loaded or does not exist (have you called manager.load()?)");
+        };
+        {
+            // Fail fast before opening the library; checked again when swapping
+            ReadSection section(pimpl->domain);
+            if (!pimpl->registry.load(std::memory_order_seq_cst)->claims(plugin_name)) {
+                throw not_loaded();
+            }
         }
 
-        pimpl->plugins[plugin_name].instance = { raw_instance, {destroyer} };
-        pimpl->plugins[plugin_name].library_handle = handle;
+        Impl::LoadProbe probe(*pimpl, library_path);
+        try {
+            auto plugin = pimpl->open_library(library_path, options, probe);
+            Impl::instantiate(*plugin, library_path, probe);
+            if (plugin->name != plugin_name) {
+                throw exception::PluginLoadError("Plugin in '" + library_path.string() + "' reports the name '" + plugin->name +
+                                                 "' and cannot replace '" + plugin_name + "'.");
+            }
+            if (plugin->library->warmer) {
+                // Warm the replacement before it takes over, while the old plugin keeps serving
+                profile::TraceSpan warmup_span("manager", "warmup", plugin_name);
+                plugin->library->warmer(plugin->instance.get());
+                plugin->warm = true;
+            }
+
+            {
+                Impl::Writer writer(*pimpl);
+                const Impl::Registry& current = writer.current();
+                const auto lazy = current.lazy.find(plugin_name);
+                if (lazy == current.lazy.end() && !current.plugins.contains(plugin_name)) {
+                    throw not_loaded();
+                }
+
+                auto next = std::make_unique<Impl::Registry>(current);
+                if (lazy != current.lazy.end()) {
+                    next->lazy[plugin_name] = Impl::make_lazy(library_path, plugin_name, options);
+                    plugin->lazy = true;
+                    plugin->touch();
+                }
+                if (next->plugins.contains(plugin_name)) {
+                    pimpl->remove(*next, plugin_name);
+                }
+                pimpl->add(*next, std::move(plugin));
+                writer.publish(std::move(next));
+            }
+            probe.lap(&PluginLoadStats::name_check);
+        } catch (...) {
+            probe.failed(std::current_exception(), plugin_name);
+            throw;
+        }
+        probe.succeeded(plugin_name);
     }
 
     void manager::PluginManager::unload(const std::string& plugin_name) const {
-        if (const auto it = pimpl->plugins.find(plugin_name); it != pimpl->plugins.end()) {
-            it->second.instance.reset();
+        (void)pimpl->unload(plugin_name);
+    }
 
-            dlclose(it->second.library_handle);
-            pimpl->plugins.erase(it);
+    std::expected<void, exception::PluginErrorCode> manager::PluginManager::try_unload(const std::string& plugin_name) const noexcept {
+        try {
+            if (!pimpl->unload(plugin_name)) {
+                return std::unexpected(exception::PluginErrorCode::NotLoaded);
+            }
+            return {};
+        } catch (...) {
+            return std::unexpected(error_code(std::current_exception()));
         }
     }
 
-    IPlugin* manager::PluginManager::get_raw(const std::string& plugin_name) const {
-        if (const auto it = pimpl->plugins.find(plugin_name); it != pimpl->plugins.end()) {
-            return it->second.instance.get();
+    void manager::PluginManager::register_lazy(const std::filesystem::path& library_path, const std::string& plugin_name, const LoadOptions& options) const {
+        auto entry = Impl::make_lazy(library_path, plugin_name, options);
+
+        Impl::Writer writer(*pimpl);
+        const Impl::Registry& current = writer.current();
+        if (current.claims(plugin_name)) {
+            throw exception::PluginNameCollisionError("A plugin with the name '" + plugin_name + "' is already loaded.");
+        }
+
+        auto next = std::make_unique<Impl::Registry>(current);
+        next->lazy.emplace(plugin_name, std::move(entry));
+        writer.publish(std::move(next));
+    }
+
+    void manager::PluginManager::register_lazy(const std::filesystem::path& library_path, const LoadOptions& options) const {
+        const auto metadata = inspect(library_path);
+        if (!metadata) {
+            throw exception::PluginLoadError("Plugin library '" + library_path.string() + "' carries no plugin metadata note; register it under an explicit name.");
+        }
+        register_lazy(library_path, metadata->name, options);
+    }
+
+    PluginCatalog manager::PluginManager::scan(const std::filesystem::path& directory, const std::filesystem::path& cache_file, const LoadOptions& options) const {
+        PluginCatalog catalog = scan_directory(directory, cache_file);
+
+        Impl::Writer writer(*pimpl);
+        auto next = std::make_unique<Impl::Registry>(writer.current());
+        bool registered = false;
+        for (const CatalogEntry& entry : catalog.entries) {
+            if (!entry.metadata || next->claims(entry.metadata->name)) {
+                continue;
+            }
+            next->lazy.emplace(entry.metadata->name, Impl::make_lazy(entry.path, entry.metadata->name, options));
+            registered = true;
+        }
+        if (registered) {
+            writer.publish(std::move(next));
+        }
+        return catalog;
+    }
+
+    std::size_t manager::PluginManager::evict_idle(const std::chrono::steady_clock::duration idle_for) const {
+        return pimpl->evict_idle(idle_for);
+    }
+
+    void manager::PluginManager::set_idle_eviction(const std::chrono::milliseconds idle_for) const {
+        std::lock_guard lock(pimpl->eviction_mutex);
+        pimpl->evictor = {}; // requests stop and joins the previous thread, if any
+        if (idle_for <= std::chrono::milliseconds::zero()) {
+            return;
+        }
+
+        const auto interval = std::max(idle_for / 2, std::chrono::milliseconds(1));
+        pimpl->evictor = std::jthread([impl = pimpl.get(), idle_for, interval](const std::stop_token& stop) {
+            std::mutex sleep_mutex;
+            std::unique_lock sleep_lock(sleep_mutex);
+            while (!impl->eviction_cv.wait_for(sleep_lock, stop, interval, [&stop] { return stop.stop_requested(); })) {
+                impl->evict_idle(idle_for);
+            }
+        });
+    }
+
+    manager::PluginManager::RawPlugin manager::PluginManager::get_raw(const std::string& plugin_name) const {
+        const ResolvedPlugin resolved = pimpl->find(plugin_name);
+        return {resolved.plugin, resolved.indexed};
+    }
+
+    Concurrency manager::PluginManager::concurrency(const std::string& plugin_name) const {
+        const std::optional<Concurrency> concurrency = pimpl->visit(plugin_name, [](const Impl::PluginRecord& record) {
+            return record.indexed ? record.instance->concurrency() : Concurrency::Serialized;
+        });
+        if (!concurrency) {
+            throw exception::PluginNotLoadedError(plugin_name + " has not been loaded or does not exist (have you called manager.load()?)");
+        }
+        return *concurrency;
+    }
+
+    void* manager::PluginManager::get_symbol_raw(const std::string& plugin_name, const std::string_view symbol_name) const {
+        const std::optional<void*> symbol = pimpl->symbol(plugin_name, symbol_name);
+        if (!symbol) {
+            throw exception::PluginNotLoadedError(plugin_name + " has not been loaded or does not exist (have you called manager.load()?)");
+        }
+        return *symbol;
+    }
+
+    std::expected<void*, exception::PluginErrorCode> manager::PluginManager::try_get_symbol_raw(const std::string& plugin_name, const std::string_view symbol_name) const noexcept {
+        try {
+            const std::optional<void*> symbol = pimpl->symbol(plugin_name, symbol_name);
+            if (!symbol) {
+                return std::unexpected(exception::PluginErrorCode::NotLoaded);
+            }
+            if (!*symbol) {
+                return std::unexpected(exception::PluginErrorCode::MissingSymbol);
+            }
+            return *symbol;
+        } catch (...) {
+            return std::unexpected(error_code(std::current_exception()));
+        }
+    }
+
+    const void* manager::PluginManager::get_function_table_raw(const std::string& plugin_name, const interface_id_t table_id, const std::size_t min_size) const {
+        const std::optional<const void*> table = pimpl->function_table(plugin_name, table_id, min_size);
+        if (!table) {
+            throw exception::PluginNotLoadedError(plugin_name + " has not been loaded or does not exist (have you called manager.load()?)");
+        }
+        return *table;
+    }
+
+    std::expected<const void*, exception::PluginErrorCode> manager::PluginManager::try_get_function_table_raw(const std::string& plugin_name, const interface_id_t table_id, const std::size_t min_size) const noexcept {
+        try {
+            const std::optional<const void*> table = pimpl->function_table(plugin_name, table_id, min_size);
+            if (!table) {
+                return std::unexpected(exception::PluginErrorCode::NotLoaded);
+            }
+            if (!*table) {
+                return std::unexpected(exception::PluginErrorCode::MissingSymbol);
+            }
+            return *table;
+        } catch (...) {
+            return std::unexpected(error_code(std::current_exception()));
+        }
+    }
+
+    std::expected<manager::PluginManager::RawPlugin, exception::PluginErrorCode> manager::PluginManager::try_get_raw(const std::string& plugin_name) const noexcept {
+        try {
+            if (const ResolvedPlugin resolved = pimpl->find(plugin_name); resolved.plugin) {
+                return RawPlugin{resolved.plugin, resolved.indexed};
+            }
+            return std::unexpected(exception::PluginErrorCode::NotLoaded);
+        } catch (...) {
+            return std::unexpected(error_code(std::current_exception())); // A lazily registered plugin failed to load
+        }
+    }
+
+    manager::PluginManager::ResolvedPlugin manager::PluginManager::resolve_raw(const std::string& plugin_name) const {
+        return pimpl->find(plugin_name);
+    }
+
+    std::shared_ptr<const std::vector<void*>> manager::PluginManager::find_indexed(const interface_id_t id, const interface_cast_t cast) const {
+        ReadSection section(pimpl->domain);
+        const Impl::Registry& current = *pimpl->registry.load(std::memory_order_seq_cst);
+
+        Impl::InterfaceList indexed;
+        if (const auto it = current.interfaces.find(id); it != current.interfaces.end()) {
+            indexed = it->second;
+        }
+        if (current.unindexed.empty()) {
+            return indexed;
+        }
+
+        auto merged = indexed ? std::make_shared<std::vector<void*>>(*indexed) : std::make_shared<std::vector<void*>>();
+        for (IPlugin* plugin : current.unindexed) {
+            if (void* interface = cast(plugin)) {
+                merged->push_back(interface);
+            }
+        }
+        return merged;
+    }
+
+    std::shared_ptr<const std::vector<void*>> manager::PluginManager::find_by_cast(const interface_cast_t cast) const {
+        ReadSection section(pimpl->domain);
+        const Impl::Registry& current = *pimpl->registry.load(std::memory_order_seq_cst);
+
+        auto matches = std::make_shared<std::vector<void*>>();
+        for (const auto& record : current.plugins | std::views::values) {
+            if (void* interface = cast(record->instance.get())) {
+                matches->push_back(interface);
+            }
         }
-        return nullptr;
+        return matches;
     }
 
 }
@@ -0,0 +1,168 @@
+#include "fourdst/plugin/profile/latency.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    std::atomic<std::uint64_t> g_next_recorder_id{1};
+
+    /**
+     * @brief Shards the thread has recorded into, beyond the cached one.
+     *
+     * Shards are owned by their recorder; entries of destroyed recorders are
+     * dropped the next time the thread registers with a recorder.
+     */
+    struct ThreadShards {
+        struct Entry {
+            std::uint64_t recorder;
+            void* shard;
+            std::weak_ptr<const void> alive;
+        };
+        std::vector<Entry> entries;
+    };
+
+    thread_local ThreadShards t_shards;
+
+    void append_duration(std::string& out, const char* key, const std::chrono::nanoseconds duration) {
+        out += ", \"";
+        out += key;
+        out += "_ns\": " + std::to_string(duration.count());
+    }
+}
+
+namespace fourdst::plugin::profile {
+
+    void LatencyHistogram::record(const std::chrono::nanoseconds latency, const std::uint64_t count) noexcept {
+        if (count == 0) {
+            return;
+        }
+        const std::uint64_t ns = latency.count() > 0 ? static_cast<std::uint64_t>(latency.count()) : 0;
+        m_buckets[bucket_index(ns)] += count;
+        m_count += count;
+        m_sum += ns * count;
+        m_min = std::min(m_min, ns);
+        m_max = std::max(m_max, ns);
+    }
+
+    void LatencyHistogram::merge(const LatencyHistogram& other) noexcept {
+        for (std::size_t i = 0; i < kBucketCount; ++i) {
+            m_buckets[i] += other.m_buckets[i];
+        }
+        m_count += other.m_count;
+        m_sum += other.m_sum;
+        m_min = std::min(m_min, other.m_min);
+        m_max = std::max(m_max, other.m_max);
+    }
+
+    std::chrono::nanoseconds LatencyHistogram::min() const noexcept {
+        return std::chrono::nanoseconds(m_count ? m_min : 0);
+    }
+
+    std::chrono::nanoseconds LatencyHistogram::mean() const noexcept {
+        return std::chrono::nanoseconds(m_count ? m_sum / m_count : 0);
+    }
+
+    std::chrono::nanoseconds LatencyHistogram::percentile(const double percent) const noexcept {
+        if (m_count == 0) {
+            return std::chrono::nanoseconds(0);
+        }
+        const double clamped = std::clamp(percent, 0.0, 100.0);
+        const auto rank = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(std::ceil(clamped / 100.0 * static_cast<double>(m_count))));
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i < kBucketCount; ++i) {
+            seen += m_buckets[i];
+            if (seen >= rank) {
+                return std::chrono::nanoseconds(std::clamp(bucket_upper_bound(i), m_min, m_max));
+            }
+        }
+        return max();
+    }
+
+    LatencyRecorder::LatencyRecorder(const std::uint32_t sample_every) :
+        m_id(g_next_recorder_id.fetch_add(1, std::memory_order_relaxed)), m_sample_every(std::max<std::uint32_t>(1, sample_every)),
+        m_alive(std::make_shared<const bool>(true)) {}
+
+    LatencyRecorder::~LatencyRecorder() = default;
+
+    LatencyRecorder::Shard* LatencyRecorder::register_thread() noexcept {
+        auto& entries = t_shards.entries;
+        for (const auto& entry : entries) {
+            if (entry.recorder == m_id) {
+                t_last = {m_id, static_cast<Shard*>(entry.shard)};
+                return t_last.shard;
+            }
+        }
+        std::erase_if(entries, [](const ThreadShards::Entry& entry) { return entry.alive.expired(); });
+
+        // Recording must not throw from inside a timed call: on failure the caller drops
+        // its sample and the thread registers again on its next one.
+        try {
+            entries.reserve(entries.size() + 1);
+            auto owned = std::make_unique<Shard>();
+            Shard* shard = owned.get();
+            {
+                std::lock_guard lock(m_mutex);
+                m_shards.push_back(std::move(owned));
+            }
+            entries.push_back({m_id, shard, m_alive});
+            t_last = {m_id, shard};
+            return shard;
+        } catch (...) {
+            return nullptr;
+        }
+    }
+
+    LatencyHistogram LatencyRecorder::snapshot() const {
+        LatencyHistogram merged;
+        std::lock_guard lock(m_mutex);
+        for (const auto& shard : m_shards) {
+            std::uint64_t count = 0;
+            for (std::size_t i = 0; i < LatencyHistogram::kBucketCount; ++i) {
+                const std::uint64_t n = shard->buckets[i].load(std::memory_order_relaxed);
+                merged.m_buckets[i] += n;
+                count += n;
+            }
+            if (count == 0) {
+                continue;
+            }
+            // Derived from the buckets so that count and percentiles always agree
+            merged.m_count += count;
+            merged.m_sum += shard->sum.load(std::memory_order_relaxed);
+            merged.m_min = std::min(merged.m_min, shard->min.load(std::memory_order_relaxed));
+            merged.m_max = std::max(merged.m_max, shard->max.load(std::memory_order_relaxed));
+        }
+        return merged;
+    }
+
+    LatencyRecorder& MethodProfile::method(const std::string_view name) {
+        std::lock_guard lock(m_mutex);
+        auto it = m_methods.find(name);
+        if (it == m_methods.end()) {
+            it = m_methods.emplace(std::string(name), std::make_unique<LatencyRecorder>(m_sample_every)).first;
+        }
+        return *it->second;
+    }
+
+    std::map<std::string, LatencyHistogram, std::less<>> MethodProfile::snapshot() const {
+        std::map<std::string, LatencyHistogram, std::less<>> histograms;
+        std::lock_guard lock(m_mutex);
+        for (const auto& [name, recorder] : m_methods) {
+            histograms.emplace(name, recorder->snapshot());
+        }
+        return histograms;
+    }
+
+    std::string to_json(const LatencyHistogram& histogram) {
+        std::string out = "{\"count\": " + std::to_string(histogram.count());
+        append_duration(out, "min", histogram.min());
+        append_duration(out, "mean", histogram.mean());
+        append_duration(out, "p50", histogram.percentile(50.0));
+        append_duration(out, "p90", histogram.percentile(90.0));
+        append_duration(out, "p99", histogram.percentile(99.0));
+        append_duration(out, "p999", histogram.percentile(99.9));
+        append_duration(out, "max", histogram.max());
+        out += '}';
+        return out;
+    }
+
+}
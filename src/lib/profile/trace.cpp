@@ -0,0 +1,273 @@
+#include "fourdst/plugin/profile/trace.h"
+#include "utils/json.h"
+
+#include <algorithm>
+#include <bit>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    struct Event {
+        const char* category;
+        const char* name;
+        Clock::time_point start;
+        Clock::duration duration;
+        std::size_t detail_length;
+        char detail[fourdst::plugin::profile::Tracer::kMaxDetail];
+    };
+
+    /**
+     * @brief Single-producer single-consumer ring of the spans of one thread.
+     *
+     * The owning thread pushes; the session's flusher pops.
+     */
+    struct Ring {
+        Ring(const std::size_t capacity, const std::uint32_t thread_index) :
+            events(capacity), mask(capacity - 1), tid(thread_index) {}
+
+        void push(const Event& event) noexcept {
+            const std::uint64_t h = head.load(std::memory_order_relaxed);
+            if (h - tail.load(std::memory_order_acquire) > mask) {
+                dropped.store(dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                return;
+            }
+            events[h & mask] = event;
+            head.store(h + 1, std::memory_order_release);
+        }
+
+        std::vector<Event> events;
+        const std::uint64_t mask;
+        const std::uint32_t tid;
+        alignas(64) std::atomic<std::uint64_t> head{0};    ///< Written by the owning thread
+        alignas(64) std::atomic<std::uint64_t> tail{0};    ///< Written by the flusher
+        std::atomic<std::uint64_t> dropped{0};             ///< Written by the owning thread
+        std::atomic<bool> retired{false};                  ///< Set once the owning thread has exited
+    };
+
+    struct Session {
+        std::uint64_t id = 0;
+        std::FILE* file = nullptr;
+        std::size_t ring_capacity = 0;
+        Clock::duration flush_interval{};
+        Clock::time_point origin = Clock::now();
+        long pid = static_cast<long>(::getpid());
+
+        std::mutex rings_mutex;
+        std::vector<std::shared_ptr<Ring>> rings; ///< Guarded by rings_mutex
+        std::uint32_t next_tid = 1;               ///< Guarded by rings_mutex
+
+        std::mutex wake_mutex;
+        std::condition_variable wake;
+        bool stopping = false;                    ///< Guarded by wake_mutex
+        std::thread flusher;
+
+        // Flusher thread only (and stop() once the flusher has been joined)
+        std::string buffer;
+        std::uint64_t written = 0;
+        std::uint64_t dropped = 0;                ///< Drops of rings that have been retired
+
+        void append(const Event& event, const std::uint32_t tid) {
+            const auto micros = [this](const Clock::duration duration) {
+                const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+                char text[32];
+                std::snprintf(text, sizeof(text), "%lld.%03lld", static_cast<long long>(ns / 1000), static_cast<long long>(ns % 1000));
+                buffer += text;
+            };
+            buffer += written++ ? ",\n{\"name\": " : "\n{\"name\": ";
+            fourdst::plugin::detail::append_json_string(buffer, event.name);
+            buffer += ", \"cat\": ";
+            fourdst::plugin::detail::append_json_string(buffer, event.category);
+            buffer += ", \"ph\": \"X\", \"ts\": ";
+            micros(std::max(event.start - origin, Clock::duration::zero()));
+            buffer += ", \"dur\": ";
+            micros(event.duration);
+            buffer += ", \"pid\": " + std::to_string(pid) + ", \"tid\": " + std::to_string(tid);
+            if (event.detail_length) {
+                buffer += ", \"args\": {\"detail\": ";
+                fourdst::plugin::detail::append_json_string(buffer, std::string_view(event.detail, event.detail_length));
+                buffer += '}';
+            }
+            buffer += '}';
+        }
+
+        /**
+         * @brief Write every span buffered so far and retire the rings of exited threads.
+         */
+        void drain() {
+            std::vector<std::shared_ptr<Ring>> snapshot;
+            {
+                std::lock_guard lock(rings_mutex);
+                snapshot = rings;
+            }
+            for (const auto& ring : snapshot) {
+                const std::uint64_t head = ring->head.load(std::memory_order_acquire);
+                std::uint64_t tail = ring->tail.load(std::memory_order_relaxed);
+                for (; tail != head; ++tail) {
+                    append(ring->events[tail & ring->mask], ring->tid);
+                }
+                ring->tail.store(tail, std::memory_order_release);
+            }
+            if (!buffer.empty()) {
+                std::fwrite(buffer.data(), 1, buffer.size(), file);
+                buffer.clear();
+            }
+            snapshot.clear();
+
+            std::lock_guard lock(rings_mutex);
+            std::erase_if(rings, [this](const std::shared_ptr<Ring>& ring) {
+                // The thread has exited, so nothing can be pushed any more
+                const bool retired = ring->retired.load(std::memory_order_acquire) &&
+                    ring->head.load(std::memory_order_relaxed) == ring->tail.load(std::memory_order_relaxed);
+                if (retired) {
+                    dropped += ring->dropped.load(std::memory_order_relaxed);
+                }
+                return retired;
+            });
+        }
+
+        void run() {
+            std::unique_lock lock(wake_mutex);
+            while (!stopping) {
+                wake.wait_for(lock, flush_interval, [this] { return stopping; });
+                lock.unlock();
+                drain();
+                lock.lock();
+            }
+        }
+    };
+
+    std::mutex g_mutex;                          ///< Serializes start, stop and ring registration
+    std::shared_ptr<Session> g_session;          ///< Guarded by g_mutex
+    std::atomic<std::uint64_t> g_session_id{0};  ///< Id of the running session, 0 if none
+    std::uint64_t g_next_session_id = 1;         ///< Guarded by g_mutex
+
+    /**
+     * @brief The calling thread's ring and the session it belongs to.
+     */
+    struct ThreadRing {
+        ~ThreadRing() {
+            if (ring) {
+                ring->retired.store(true, std::memory_order_release);
+            }
+        }
+
+        std::uint64_t session = 0;
+        std::shared_ptr<Ring> ring;
+    };
+
+    thread_local ThreadRing t_ring;
+
+    /**
+     * @brief Give the calling thread a ring in the given session, if that session is still running.
+     */
+    Ring* register_thread(const std::uint64_t session_id) {
+        std::lock_guard lock(g_mutex);
+        if (!g_session || g_session->id != session_id) {
+            return nullptr;
+        }
+        std::lock_guard rings_lock(g_session->rings_mutex);
+        auto ring = std::make_shared<Ring>(g_session->ring_capacity, g_session->next_tid++);
+        g_session->rings.push_back(ring);
+        if (t_ring.ring) {
+            t_ring.ring->retired.store(true, std::memory_order_release); // Left behind by an earlier trace
+        }
+        t_ring.session = session_id;
+        t_ring.ring = std::move(ring);
+        return t_ring.ring.get();
+    }
+}
+
+namespace fourdst::plugin::profile {
+
+    std::atomic<bool> Tracer::s_enabled{false};
+
+    void Tracer::start(const std::filesystem::path& output, const TraceOptions& options) {
+        std::lock_guard lock(g_mutex);
+        if (g_session) {
+            throw std::runtime_error("A trace is already being written.");
+        }
+        std::FILE* file = std::fopen(output.c_str(), "wb");
+        if (!file) {
+            throw std::runtime_error("Failed to open trace file: " + output.string());
+        }
+        std::fputs("{\"traceEvents\": [", file);
+
+        auto session = std::make_shared<Session>();
+        session->id = g_next_session_id++;
+        session->file = file;
+        session->ring_capacity = std::bit_ceil(std::max<std::size_t>(options.ring_capacity, 2));
+        session->flush_interval = std::max(options.flush_interval, std::chrono::milliseconds(1));
+        session->flusher = std::thread([raw = session.get()] { raw->run(); });
+
+        g_session = std::move(session);
+        g_session_id.store(g_session->id, std::memory_order_release);
+        s_enabled.store(true, std::memory_order_relaxed);
+    }
+
+    TraceSummary Tracer::stop() {
+        std::shared_ptr<Session> session;
+        {
+            std::lock_guard lock(g_mutex);
+            session = std::move(g_session);
+            g_session_id.store(0, std::memory_order_release);
+            s_enabled.store(false, std::memory_order_relaxed);
+        }
+        if (!session) {
+            return {};
+        }
+
+        {
+            std::lock_guard lock(session->wake_mutex);
+            session->stopping = true;
+        }
+        session->wake.notify_one();
+        session->flusher.join();
+        session->drain();
+
+        TraceSummary summary{session->written, session->dropped};
+        for (const auto& ring : session->rings) {
+            summary.dropped += ring->dropped.load(std::memory_order_relaxed);
+        }
+        const std::string trailer = "\n], \"displayTimeUnit\": \"ns\", \"otherData\": {\"dropped_events\": " +
+                                    std::to_string(summary.dropped) + "}}\n";
+        std::fputs(trailer.c_str(), session->file);
+        std::fclose(session->file);
+        return summary;
+    }
+
+    void Tracer::record(const char* category, const char* name, const std::string_view detail,
+                        const std::chrono::steady_clock::time_point start, const std::chrono::steady_clock::time_point end) noexcept {
+        const std::uint64_t session_id = g_session_id.load(std::memory_order_acquire);
+        if (session_id == 0) {
+            return;
+        }
+        Ring* ring = t_ring.session == session_id ? t_ring.ring.get() : nullptr;
+        if (!ring) {
+            try {
+                ring = register_thread(session_id);
+            } catch (...) {
+                return; // Out of memory: lose the span rather than the process
+            }
+            if (!ring) {
+                return;
+            }
+        }
+
+        const std::string_view kept = truncate_detail(detail);
+        Event event{category, name, start, end - start, kept.size(), {}};
+        std::memcpy(event.detail, kept.data(), kept.size());
+        ring->push(event);
+    }
+
+}
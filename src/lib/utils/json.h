@@ -0,0 +1,18 @@
+/**
+ * @file json.h
+ * @brief JSON helpers shared by the library's serializers; not installed
+ */
+
+#pragma once
+
+#include <string>
+#include <string_view>
+
+namespace fourdst::plugin::detail {
+
+    /**
+     * @brief Append text to out as a quoted, escaped JSON string
+     */
+    void append_json_string(std::string& out, std::string_view text);
+
+}
@@ -0,0 +1,83 @@
+/**
+ * @file batch_apply.cpp
+ * @brief Throughput of a functor plugin called per element versus in batches
+ *
+ * Processes N points (default 10,000,000, override with argv[1]) through
+ * - per element: one FunctorPlugin_T::operator() call per point
+ * - default apply: FunctorPlugin_T::apply of a functor that does not override it
+ * - apply: the functor mock's own apply override
+ * and reports the best throughput over a few rounds in millions of points per second.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include "fourdst/plugin/plugin.h"
+#include "mocks/mock_interfaces.h"
+#include "synthetic.h"
+
+std::atomic<bool> g_destructor_called = false;
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+    using Functor = fourdst::plugin::templates::FunctorPlugin_T<ExampleContext>;
+    constexpr int kRounds = 5;
+
+    // Forwards single calls to the plugin and keeps the default, per-element apply()
+    class ScalarOnly final : public Functor {
+    public:
+        explicit ScalarOnly(const Functor& inner) : Functor(inner.get_name(), inner.get_version()), m_inner(inner) {}
+        ExampleContext operator()(const ExampleContext& input) const override { return m_inner(input); }
+
+    private:
+        const Functor& m_inner;
+    };
+
+    template<typename Run>
+    double best_mpoints_per_second(const std::vector<ExampleContext>& in, std::vector<ExampleContext>& out, Run&& run) {
+        double best = 0.0;
+        for (int round = 0; round < kRounds; ++round) {
+            const auto begin = Clock::now();
+            run(in, out);
+            const std::chrono::duration<double, std::micro> elapsed = Clock::now() - begin;
+            best = std::max(best, static_cast<double>(in.size()) / elapsed.count());
+        }
+        if (out.back().value != in.back().value * 2) {
+            std::printf("(unexpected result)\n");
+        }
+        return best;
+    }
+}
+
+int main(int argc, char** argv) {
+    const std::size_t count = fourdst::plugin::benchmarks::count_argument(argc, argv, 10'000'000);
+    auto& manager = fourdst::plugin::manager::PluginManager::getInstance();
+    manager.load(FUNCTOR_PLUGIN_PATH);
+    const Functor& functor = *manager.get<IExampleFunctor>("FunctorPlugin");
+    const ScalarOnly scalar_only(functor);
+
+    std::vector<ExampleContext> in(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        in[i] = {static_cast<int>(i % 1000), 0.0};
+    }
+    std::vector<ExampleContext> out(count);
+
+    const double per_element = best_mpoints_per_second(in, out, [&](const auto& input, auto& output) {
+        for (std::size_t i = 0; i < input.size(); ++i) {
+            output[i] = functor(input[i]);
+        }
+    });
+    const double default_apply = best_mpoints_per_second(in, out, [&](const auto& input, auto& output) {
+        static_cast<const Functor&>(scalar_only).apply(input, output);
+    });
+    const double batched = best_mpoints_per_second(in, out, [&](const auto& input, auto& output) {
+        functor.apply(input, output);
+    });
+
+    std::printf("%12s %14s %14s %14s   (million points/s)\n", "points", "per element", "default apply", "apply");
+    std::printf("%12zu %14.1f %14.1f %14.1f\n", count, per_element, default_apply, batched);
+    return 0;
+}
@@ -0,0 +1,61 @@
+/**
+ * @file boot_time.cpp
+ * @brief Wall-clock time to load N plugins with sequential load() versus load_all()
+ *
+ * Loads N synthetic plugins (default 300, override with argv[1]) either one by
+ * one or as a single batch, unloading everything between rounds. Rounds
+ * alternate between the two modes to even out page cache effects.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "fourdst/plugin/plugin.h"
+#include "fourdst/plugin/bundle/utils.h"
+#include "mocks/mock_interfaces.h"
+#include "synthetic.h"
+
+std::atomic<bool> g_destructor_called = false;
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+    constexpr int kRounds = 3;
+}
+
+int main(int argc, char** argv) {
+    const std::size_t count = fourdst::plugin::benchmarks::count_argument(argc, argv, 300);
+    const fourdst::plugin::bundle::utils::TemporaryDirectory directory;
+    const auto paths = fourdst::plugin::benchmarks::make_synthetic_plugins(directory.get_path(), count);
+
+    auto& manager = fourdst::plugin::manager::PluginManager::getInstance();
+    const auto unload_all = [&] {
+        for (const auto& path : paths) {
+            manager.unload(path.stem().string());
+        }
+    };
+
+    std::printf("%6s %14s %14s\n", "round", "serial (ms)", "load_all (ms)");
+    for (int round = 0; round < kRounds; ++round) {
+        auto begin = Clock::now();
+        for (const auto& path : paths) {
+            manager.load(path);
+        }
+        const std::chrono::duration<double, std::milli> serial = Clock::now() - begin;
+        unload_all();
+
+        begin = Clock::now();
+        const auto report = manager.load_all(paths);
+        const std::chrono::duration<double, std::milli> batched = Clock::now() - begin;
+        if (!report.ok()) {
+            std::fprintf(stderr, "%zu plugins failed to load, first: %s\n", report.failures.size(), report.failures.front().message.c_str());
+            return 1;
+        }
+        unload_all();
+
+        std::printf("%6d %14.2f %14.2f\n", round, serial.count(), batched.count());
+    }
+    return 0;
+}
@@ -0,0 +1,58 @@
+/**
+ * @file catalog_scan.cpp
+ * @brief Cold versus warm scans of a plugin directory with scan_directory()
+ *
+ * Creates N synthetic plugins (default 5000, override with argv[1]) and scans
+ * the directory
+ * - cold: without an index, so every library is mapped and its note parsed
+ * - warm: with the index written by the previous scan, so no library is opened
+ * - after touching 1% of the libraries, which are the only ones re-inspected
+ * followed by PluginManager::scan(), which also registers every plugin lazily.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+
+#include "fourdst/plugin/plugin.h"
+#include "fourdst/plugin/bundle/utils.h"
+#include "synthetic.h"
+
+std::atomic<bool> g_destructor_called = false;
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    template<typename Fn>
+    void report(const char* label, Fn&& fn) {
+        const auto begin = Clock::now();
+        const fourdst::plugin::PluginCatalog catalog = fn();
+        const std::chrono::duration<double, std::milli> elapsed = Clock::now() - begin;
+        std::printf("%-26s %10.2f ms  (%zu libraries, %zu inspected, %zu cached)\n",
+                    label, elapsed.count(), catalog.entries.size(), catalog.inspected, catalog.cached);
+    }
+}
+
+int main(int argc, char** argv) {
+    const std::size_t count = fourdst::plugin::benchmarks::count_argument(argc, argv, 5000);
+    const fourdst::plugin::bundle::utils::TemporaryDirectory directory;
+    const auto paths = fourdst::plugin::benchmarks::make_synthetic_plugins(directory.get_path(), count);
+    const auto index = directory.get_path() / fourdst::plugin::kCatalogFileName;
+
+    report("cold scan (no index)", [&] { return fourdst::plugin::scan_directory(directory.get_path()); });
+    report("warm scan", [&] { return fourdst::plugin::scan_directory(directory.get_path()); });
+
+    const auto later = std::filesystem::file_time_type::clock::now() + std::chrono::seconds(1);
+    for (std::size_t i = 0; i < paths.size(); i += 100) {
+        std::filesystem::last_write_time(paths[i], later);
+    }
+    report("warm scan, 1% modified", [&] { return fourdst::plugin::scan_directory(directory.get_path()); });
+
+    std::filesystem::remove(index);
+    report("cold scan (no index)", [&] { return fourdst::plugin::scan_directory(directory.get_path()); });
+
+    auto& manager = fourdst::plugin::manager::PluginManager::getInstance();
+    report("PluginManager::scan (warm)", [&] { return manager.scan(directory.get_path()); });
+    return 0;
+}
@@ -0,0 +1,72 @@
+/**
+ * @file function_table.cpp
+ * @brief Per-element cost of calling a functor plugin through its interface versus its function table
+ *
+ * Applies the functor mock to N elements (default 10,000,000, override with
+ * argv[1]) through
+ * - virtual: FunctorPlugin_T::operator() on the interface pointer
+ * - table: the apply entry of the plugin's ExampleFunctorTable, kept in a local
+ * - batch: one apply_all call from the same table for the whole array
+ * and reports the best mean time per element in nanoseconds over a few rounds.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <limits>
+#include <vector>
+
+#include "fourdst/plugin/plugin.h"
+#include "mocks/mock_interfaces.h"
+#include "synthetic.h"
+
+std::atomic<bool> g_destructor_called = false;
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+    constexpr int kRounds = 5;
+
+    template<typename Apply>
+    double best_ns_per_element(std::vector<ExampleContext>& values, Apply&& apply) {
+        double best = std::numeric_limits<double>::max();
+        for (int round = 0; round < kRounds; ++round) {
+            std::ranges::fill(values, ExampleContext{1, 0.0});
+            const auto begin = Clock::now();
+            apply(values);
+            const std::chrono::duration<double, std::nano> elapsed = Clock::now() - begin;
+            best = std::min(best, elapsed.count() / static_cast<double>(values.size()));
+        }
+        if (values.front().value == 0) {
+            std::printf("(unexpected result)\n");
+        }
+        return best;
+    }
+}
+
+int main(int argc, char** argv) {
+    const std::size_t count = fourdst::plugin::benchmarks::count_argument(argc, argv, 10'000'000);
+    auto& manager = fourdst::plugin::manager::PluginManager::getInstance();
+    manager.load(FUNCTOR_PLUGIN_PATH);
+    const IExampleFunctor& functor = *manager.get<IExampleFunctor>("FunctorPlugin");
+    const ExampleFunctorTable table = manager.get_function_table<ExampleFunctorTable>("FunctorPlugin");
+
+    std::vector<ExampleContext> values(count);
+    const double virtual_ns = best_ns_per_element(values, [&](std::vector<ExampleContext>& data) {
+        for (auto& value : data) {
+            value = functor(value);
+        }
+    });
+    const double table_ns = best_ns_per_element(values, [&](std::vector<ExampleContext>& data) {
+        for (auto& value : data) {
+            value = table.apply(value);
+        }
+    });
+    const double batch_ns = best_ns_per_element(values, [&](std::vector<ExampleContext>& data) {
+        table.apply_all(data.data(), data.size());
+    });
+
+    std::printf("%12s %10s %10s %10s   (ns per element)\n", "elements", "virtual", "table", "batch");
+    std::printf("%12zu %10.2f %10.2f %10.2f\n", count, virtual_ns, table_ns, batch_ns);
+    return 0;
+}
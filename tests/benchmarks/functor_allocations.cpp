@@ -0,0 +1,174 @@
+/**
+ * @file functor_allocations.cpp
+ * @brief Heap allocations of a chain of functor stages, copying versus in place
+ *
+ * Threads a series of N points (default 10,000, override with argv[1]), each
+ * carrying a small metadata map like the DataSeries example, through three
+ * FunctorPlugin_T stages and counts the allocations of one pass:
+ * - copy: stages that only implement operator()(const T&), called as x = stage(x)
+ * - copy, consuming: the same stages called as x = stage(std::move(x)); the
+ *   default consuming operator still bridges to the copying one
+ * - transform: stages that override transform(), called as stage.transform(x)
+ * - transform, consuming: those stages called as x = stage(std::move(x))
+ * Each mode is warmed up by one pass, so the counts are the steady state.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "fourdst/plugin/plugin.h"
+#include "synthetic.h"
+
+std::atomic<bool> g_destructor_called = false;
+
+namespace {
+    std::size_t g_allocations = 0;
+}
+
+// Counting replacements of the global operators. They are a matching pair over
+// malloc/free, but GCC's -Wmismatched-new-delete cannot tell once it inlines
+// them into callers, so the warning is silenced for these definitions only.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void* operator new(const std::size_t size) {
+    ++g_allocations;
+    if (void* memory = std::malloc(size ? size : 1)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+    constexpr int kRounds = 5;
+
+    struct Point {
+        double value = 0.0;
+        std::map<std::string, std::string> metadata;
+    };
+    using Series = std::vector<Point>;
+    using Stage = fourdst::plugin::templates::FunctorPlugin_T<Series>;
+
+    // The shape of the processors before transform() existed: every call builds a new series
+    class CopyingStage final : public Stage {
+    public:
+        using Stage::Stage;
+        Series operator()(const Series& input) const override {
+            Series result;
+            result.reserve(input.size());
+            for (const Point& point : input) {
+                Point scaled = point;
+                scaled.value *= 1.0001;
+                scaled.metadata["scaled"] = "true";
+                result.push_back(std::move(scaled));
+            }
+            return result;
+        }
+    };
+
+    class InPlaceStage final : public Stage {
+    public:
+        using Stage::Stage;
+        using Stage::operator();
+        Series operator()(const Series& input) const override {
+            Series result = input;
+            transform(result);
+            return result;
+        }
+        void transform(Series& series) const override {
+            for (Point& point : series) {
+                point.value *= 1.0001;
+                point.metadata["scaled"] = "true";
+            }
+        }
+    };
+
+    Series make_series(const std::size_t count) {
+        Series series(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            series[i].value = static_cast<double>(i);
+            series[i].metadata["source"] = "sensor";
+        }
+        return series;
+    }
+
+    struct Result {
+        double allocations_per_pass;
+        double best_us;
+    };
+
+    template<typename Pass>
+    Result measure(const std::size_t count, Pass&& pass) {
+        Series series = make_series(count);
+        pass(series);
+        Result result{0.0, 0.0};
+        std::size_t allocations = 0;
+        for (int round = 0; round < kRounds; ++round) {
+            const std::size_t before = g_allocations;
+            const auto begin = Clock::now();
+            pass(series);
+            const std::chrono::duration<double, std::micro> elapsed = Clock::now() - begin;
+            allocations += g_allocations - before;
+            result.best_us = round == 0 ? elapsed.count() : std::min(result.best_us, elapsed.count());
+        }
+        if (series.size() != count || series.front().metadata.size() != 2) {
+            std::printf("(unexpected result)\n");
+        }
+        result.allocations_per_pass = static_cast<double>(allocations) / kRounds;
+        return result;
+    }
+}
+
+int main(int argc, char** argv) {
+    const std::size_t count = fourdst::plugin::benchmarks::count_argument(argc, argv, 10'000);
+    const CopyingStage copying[] = {CopyingStage("scale", "1.0.0"), CopyingStage("smooth", "1.0.0"), CopyingStage("filter", "1.0.0")};
+    const InPlaceStage in_place[] = {InPlaceStage("scale", "1.0.0"), InPlaceStage("smooth", "1.0.0"), InPlaceStage("filter", "1.0.0")};
+
+    const Result copy = measure(count, [&](Series& series) {
+        for (const Stage& stage : copying) {
+            series = stage(series);
+        }
+    });
+    const Result copy_consuming = measure(count, [&](Series& series) {
+        for (const Stage& stage : copying) {
+            series = stage(std::move(series));
+        }
+    });
+    const Result transform = measure(count, [&](Series& series) {
+        for (const Stage& stage : in_place) {
+            stage.transform(series);
+        }
+    });
+    const Result transform_consuming = measure(count, [&](Series& series) {
+        for (const Stage& stage : in_place) {
+            series = stage(std::move(series));
+        }
+    });
+
+    std::printf("%10s %20s %18s %18s\n", "points", "mode", "allocations/pass", "best pass (us)");
+    const std::pair<const char*, Result> rows[] = {
+        {"copy", copy}, {"copy, consuming", copy_consuming}, {"transform", transform}, {"transform, consuming", transform_consuming},
+    };
+    for (const auto& [mode, result] : rows) {
+        std::printf("%10zu %20s %18.0f %18.1f\n", count, mode, result.allocations_per_pass, result.best_us);
+    }
+    return 0;
+}
@@ -0,0 +1,50 @@
+/**
+ * @file handle_lookup.cpp
+ * @brief Cost of PluginManager::get<T>(name) versus a pre-resolved PluginHandle<T>
+ *
+ * Measures the per-access cost of
+ * - get<T>(name): snapshot lookup by string plus dynamic_cast on every call
+ * - handle->: the pointer cached in a PluginHandle
+ * - handle.checked_get(): the cached pointer plus a generation check
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+#include "fourdst/plugin/plugin.h"
+#include "mocks/mock_interfaces.h"
+
+std::atomic<bool> g_destructor_called = false;
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+    constexpr long kIterations = 10'000'000;
+
+    template<typename Fn>
+    void report(const char* label, Fn&& fn) {
+        long long checksum = 0;
+        const auto begin = Clock::now();
+        for (long i = 0; i < kIterations; ++i) {
+            checksum += fn();
+        }
+        const std::chrono::duration<double, std::nano> elapsed = Clock::now() - begin;
+        std::printf("%-28s %10.2f ns/call  (checksum %lld)\n", label, elapsed.count() / kIterations, checksum);
+    }
+}
+
+int main() {
+    auto& manager = fourdst::plugin::manager::PluginManager::getInstance();
+    manager.load(VALID_PLUGIN_PATH);
+    manager.load(OTHER_PLUGIN_PATH);
+    manager.load(FUNCTOR_PLUGIN_PATH);
+
+    const std::string name = "ValidPlugin";
+    auto handle = manager.resolve<IValidPlugin>(name);
+
+    report("get<T>(name)", [&] { return manager.get<IValidPlugin>(name)->get_magic_number(); });
+    report("PluginHandle<T>::operator->", [&] { return handle->get_magic_number(); });
+    report("PluginHandle<T>::checked_get", [&] { return handle.checked_get()->get_magic_number(); });
+    return 0;
+}
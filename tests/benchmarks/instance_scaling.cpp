@@ -0,0 +1,86 @@
+/**
+ * @file instance_scaling.cpp
+ * @brief Throughput of a stateful functor plugin at 1-64 threads, per instance strategy
+ *
+ * Every thread calls the stateful mock functor a fixed number of times through
+ * - shared: the manager's single instance, whose internal mutex serializes all threads
+ * - get_local<T>: the calling thread's own instance, looked up on every call
+ * - InstancePool<T>: an instance checked out for each batch of kBatch calls
+ * and the aggregate throughput in millions of calls per second is reported.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "fourdst/plugin/plugin.h"
+#include "mocks/mock_interfaces.h"
+
+std::atomic<bool> g_destructor_called = false;
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+    constexpr long kCallsPerThread = 200'000;
+    constexpr long kBatch = 256;
+    constexpr int kThreadCounts[] = {1, 2, 4, 8, 16, 32, 64};
+
+    template<typename Work>
+    double calls_per_second(const int threads, Work&& work) {
+        std::atomic<long long> checksum = 0;
+        std::vector<std::thread> workers;
+        workers.reserve(threads);
+        const auto begin = Clock::now();
+        for (int t = 0; t < threads; ++t) {
+            workers.emplace_back([&] { checksum.fetch_add(work(), std::memory_order_relaxed); });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        const std::chrono::duration<double> elapsed = Clock::now() - begin;
+        if (checksum.load() == 0) {
+            std::printf("(empty checksum)\n");
+        }
+        return static_cast<double>(threads) * kCallsPerThread / elapsed.count();
+    }
+}
+
+int main() {
+    auto& manager = fourdst::plugin::manager::PluginManager::getInstance();
+    manager.load(STATEFUL_PLUGIN_PATH);
+    const std::string name = "StatefulPlugin";
+    auto* shared = manager.get<IExampleFunctor>(name);
+    fourdst::plugin::manager::InstancePool<IExampleFunctor> pool(manager, name, 64);
+
+    std::printf("%-8s %14s %14s %14s   (Mcalls/s)\n", "threads", "shared", "get_local", "pool");
+    for (const int threads : kThreadCounts) {
+        const double shared_rate = calls_per_second(threads, [&] {
+            long long sum = 0;
+            for (long i = 0; i < kCallsPerThread; ++i) {
+                sum += (*shared)(ExampleContext{static_cast<int>(i), 0.0}).value;
+            }
+            return sum;
+        });
+        const double local_rate = calls_per_second(threads, [&] {
+            long long sum = 0;
+            for (long i = 0; i < kCallsPerThread; ++i) {
+                sum += (*manager.get_local<IExampleFunctor>(name))(ExampleContext{static_cast<int>(i), 0.0}).value;
+            }
+            return sum;
+        });
+        const double pool_rate = calls_per_second(threads, [&] {
+            long long sum = 0;
+            for (long i = 0; i < kCallsPerThread; i += kBatch) {
+                auto lease = pool.checkout();
+                for (long j = i; j < i + kBatch && j < kCallsPerThread; ++j) {
+                    sum += (*lease)(ExampleContext{static_cast<int>(j), 0.0}).value;
+                }
+            }
+            return sum;
+        });
+        std::printf("%-8d %14.2f %14.2f %14.2f\n", threads, shared_rate / 1e6, local_rate / 1e6, pool_rate / 1e6);
+    }
+    return 0;
+}
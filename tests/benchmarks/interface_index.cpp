@@ -0,0 +1,70 @@
+/**
+ * @file interface_index.cpp
+ * @brief Enumerating plugins by interface with find_all<T>() versus probing every name
+ *
+ * Loads N synthetic plugins (default 1000, override with argv[1]) that all
+ * implement IValidPlugin, then compares
+ * - probing every name with get<T>() and catching PluginTypeError
+ * - find_all<T>() for an interface with an ID (served from the interface index)
+ * - find_all<T>() for an interface without an ID (dynamic_cast scan)
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "fourdst/plugin/plugin.h"
+#include "fourdst/plugin/bundle/utils.h"
+#include "mocks/mock_interfaces.h"
+#include "synthetic.h"
+
+std::atomic<bool> g_destructor_called = false;
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    template<typename Fn>
+    void report(const char* label, const int repetitions, Fn&& fn) {
+        std::size_t found = 0;
+        const auto begin = Clock::now();
+        for (int i = 0; i < repetitions; ++i) {
+            found = fn();
+        }
+        const std::chrono::duration<double, std::micro> elapsed = Clock::now() - begin;
+        std::printf("%-44s %12.2f us/query  (%zu found)\n", label, elapsed.count() / repetitions, found);
+    }
+
+    template<typename T>
+    std::size_t probe_all(fourdst::plugin::manager::PluginManager& manager, const std::vector<std::string>& names) {
+        std::size_t found = 0;
+        for (const auto& name : names) {
+            try {
+                (void)manager.get<T>(name);
+                ++found;
+            } catch (const fourdst::plugin::exception::PluginTypeError&) {}
+        }
+        return found;
+    }
+}
+
+int main(int argc, char** argv) {
+    const std::size_t count = fourdst::plugin::benchmarks::count_argument(argc, argv, 1000);
+    const fourdst::plugin::bundle::utils::TemporaryDirectory directory;
+    const auto paths = fourdst::plugin::benchmarks::make_synthetic_plugins(directory.get_path(), count);
+
+    auto& manager = fourdst::plugin::manager::PluginManager::getInstance();
+    std::vector<std::string> names;
+    for (const auto& path : paths) {
+        manager.load(path);
+        names.push_back(path.stem().string());
+    }
+    std::printf("loaded %zu synthetic plugins\n", names.size());
+
+    report("probe get<IValidPlugin> over all names", 20, [&] { return probe_all<IValidPlugin>(manager, names); });
+    report("probe get<IExampleFunctor> (all throw)", 5, [&] { return probe_all<IExampleFunctor>(manager, names); });
+    report("find_all<IValidPlugin> (indexed)", 100000, [&] { return manager.find_all<IValidPlugin>().size(); });
+    report("find_all<IExampleFunctor> (dynamic_cast scan)", 100, [&] { return manager.find_all<IExampleFunctor>().size(); });
+    return 0;
+}
@@ -0,0 +1,82 @@
+/**
+ * @file load_scaling.cpp
+ * @brief Per-plugin load latency as the number of loaded plugins grows, per LoadOptions mode
+ *
+ * Loads N synthetic plugins (default 1000, override with argv[1]) one by one
+ * under each dlopen mode and reports the mean latency of load() over each
+ * fifth of the run, so a mode whose cost grows with the number of plugins
+ * already loaded shows up as a rising row. Everything is unloaded between modes.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "fourdst/plugin/plugin.h"
+#include "fourdst/plugin/bundle/utils.h"
+#include "synthetic.h"
+
+std::atomic<bool> g_destructor_called = false;
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+    using fourdst::plugin::manager::LoadOptions;
+    constexpr int kSlices = 5;
+
+    struct Mode {
+        const char* label;
+        LoadOptions options;
+    };
+
+    LoadOptions make_options(const LoadOptions::Binding binding, const LoadOptions::Scope scope, const bool deep_bind = false, std::string group = {}) {
+        LoadOptions options;
+        options.binding = binding;
+        options.scope = scope;
+        options.deep_bind = deep_bind;
+        options.namespace_group = std::move(group);
+        return options;
+    }
+}
+
+int main(int argc, char** argv) {
+    const std::size_t count = fourdst::plugin::benchmarks::count_argument(argc, argv, 1000);
+    const fourdst::plugin::bundle::utils::TemporaryDirectory directory;
+    const auto paths = fourdst::plugin::benchmarks::make_synthetic_plugins(directory.get_path(), count);
+    auto& manager = fourdst::plugin::manager::PluginManager::getInstance();
+
+    const std::vector<Mode> modes = {
+        {"lazy, global (default)", make_options(LoadOptions::Binding::Lazy, LoadOptions::Scope::Global)},
+        {"now, global", make_options(LoadOptions::Binding::Now, LoadOptions::Scope::Global)},
+        {"lazy, local", make_options(LoadOptions::Binding::Lazy, LoadOptions::Scope::Local)},
+        {"now, local", make_options(LoadOptions::Binding::Now, LoadOptions::Scope::Local)},
+        {"lazy, local, deepbind", make_options(LoadOptions::Binding::Lazy, LoadOptions::Scope::Local, true)},
+        {"lazy, dlmopen group", make_options(LoadOptions::Binding::Lazy, LoadOptions::Scope::Local, false, "bench")},
+    };
+
+    std::printf("%-24s", "mean load() latency (us)");
+    for (int slice = 0; slice < kSlices; ++slice) {
+        std::printf(" %7zu-%-6zu", slice * count / kSlices, (slice + 1) * count / kSlices);
+    }
+    std::printf("\n");
+
+    for (const auto& [label, options] : modes) {
+        std::printf("%-24s", label);
+        for (int slice = 0; slice < kSlices; ++slice) {
+            const std::size_t begin_index = slice * count / kSlices;
+            const std::size_t end_index = (slice + 1) * count / kSlices;
+            const auto begin = Clock::now();
+            for (std::size_t i = begin_index; i < end_index; ++i) {
+                manager.load(paths[i], options);
+            }
+            const std::chrono::duration<double, std::micro> elapsed = Clock::now() - begin;
+            std::printf(" %14.1f", elapsed.count() / static_cast<double>(end_index - begin_index));
+        }
+        std::printf("\n");
+        for (const auto& path : paths) {
+            manager.unload(path.stem().string());
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,84 @@
+/**
+ * @file profiling_overhead.cpp
+ * @brief Cost of profiling a functor plugin call, per thread count
+ *
+ * Every thread calls the functor mock a fixed number of times
+ * - direct: through the plugin pointer
+ * - profiled: through a ProfiledFunctor timing every call
+ * - sampled: through a ProfiledFunctor timing one call in 64
+ * - traced: through a ProfiledFunctor while a trace is being written
+ * and the mean time per call in nanoseconds is reported, together with the
+ * median and p99 latency the profiled proxy measured and the share of traced
+ * calls whose span was dropped because its ring was full.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <thread>
+#include <vector>
+
+#include "fourdst/plugin/plugin.h"
+#include "mocks/mock_interfaces.h"
+
+std::atomic<bool> g_destructor_called = false;
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+    using Functor = fourdst::plugin::templates::FunctorPlugin_T<ExampleContext>;
+    constexpr long kCallsPerThread = 2'000'000;
+    constexpr int kThreadCounts[] = {1, 2, 4, 8};
+
+    double ns_per_call(const int threads, const Functor& functor) {
+        std::atomic<long long> checksum = 0;
+        std::vector<std::thread> workers;
+        workers.reserve(threads);
+        const auto begin = Clock::now();
+        for (int t = 0; t < threads; ++t) {
+            workers.emplace_back([&] {
+                long long sum = 0;
+                for (long i = 0; i < kCallsPerThread; ++i) {
+                    sum += functor(ExampleContext{static_cast<int>(i), 0.0}).value;
+                }
+                checksum.fetch_add(sum, std::memory_order_relaxed);
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        const std::chrono::duration<double, std::nano> elapsed = Clock::now() - begin;
+        if (checksum.load() == 0) {
+            std::printf("(empty checksum)\n");
+        }
+        // Wall time per call of one thread; equal to the per-call cost when the threads run in parallel
+        return elapsed.count() / kCallsPerThread;
+    }
+}
+
+int main() {
+    auto& manager = fourdst::plugin::manager::PluginManager::getInstance();
+    manager.load(FUNCTOR_PLUGIN_PATH);
+    const Functor& direct = *manager.get<IExampleFunctor>("FunctorPlugin");
+
+    const std::filesystem::path trace_path = std::filesystem::temp_directory_path() / "bench_profiling_overhead.trace.json";
+    std::printf("%-8s %10s %10s %10s %10s %10s %10s   (ns)\n", "threads", "direct", "profiled", "sampled", "traced", "p50", "p99");
+    for (const int threads : kThreadCounts) {
+        const fourdst::plugin::templates::ProfiledFunctor<ExampleContext> profiled(direct);
+        const fourdst::plugin::templates::ProfiledFunctor<ExampleContext> sampled(direct, 64);
+        const double direct_ns = ns_per_call(threads, direct);
+        const double profiled_ns = ns_per_call(threads, profiled);
+        const double sampled_ns = ns_per_call(threads, sampled);
+        const auto latency = profiled.latency();
+
+        fourdst::plugin::profile::Tracer::start(trace_path);
+        const double traced_ns = ns_per_call(threads, profiled);
+        const auto trace = fourdst::plugin::profile::Tracer::stop();
+        std::printf("%-8d %10.1f %10.1f %10.1f %10.1f %10lld %10lld   (%.0f%% of spans dropped)\n", threads, direct_ns, profiled_ns,
+                    sampled_ns, traced_ns, static_cast<long long>(latency.percentile(50).count()),
+                    static_cast<long long>(latency.percentile(99).count()),
+                    100.0 * static_cast<double>(trace.dropped) / static_cast<double>(trace.dropped + trace.written));
+    }
+    std::filesystem::remove(trace_path);
+    return 0;
+}
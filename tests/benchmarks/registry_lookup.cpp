@@ -0,0 +1,87 @@
+/**
+ * @file registry_lookup.cpp
+ * @brief Lookup throughput of PluginManager::get<T> versus reader thread count
+ *
+ * Every configuration is measured twice: with an idle registry, and with a
+ * control thread that continuously loads and unloads a second plugin. Since
+ * lookups read an immutable snapshot, throughput should scale with the thread
+ * count in both cases.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <thread>
+#include <vector>
+
+#include "fourdst/plugin/plugin.h"
+#include "mocks/mock_interfaces.h"
+
+std::atomic<bool> g_destructor_called = false;
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+    constexpr auto kDuration = std::chrono::milliseconds(500);
+
+    double measure(fourdst::plugin::manager::PluginManager& manager, const unsigned threads, const bool churn) {
+        std::atomic<bool> start = false;
+        std::atomic<bool> stop = false;
+        std::atomic<unsigned long long> total = 0;
+
+        std::vector<std::thread> readers;
+        for (unsigned i = 0; i < threads; ++i) {
+            readers.emplace_back([&] {
+                while (!start.load(std::memory_order_acquire)) {}
+                unsigned long long count = 0;
+                while (!stop.load(std::memory_order_relaxed)) {
+                    for (int j = 0; j < 256; ++j) {
+                        auto* plugin = manager.get<IOtherInterface>("OtherPlugin");
+                        asm volatile("" : : "r"(plugin) : "memory");
+                    }
+                    count += 256;
+                }
+                total.fetch_add(count);
+            });
+        }
+
+        std::thread writer;
+        if (churn) {
+            writer = std::thread([&] {
+                while (!stop.load(std::memory_order_relaxed)) {
+                    manager.load(FUNCTOR_PLUGIN_PATH);
+                    manager.unload("FunctorPlugin");
+                }
+            });
+        }
+
+        const auto begin = Clock::now();
+        start.store(true, std::memory_order_release);
+        std::this_thread::sleep_for(kDuration);
+        stop = true;
+        for (auto& reader : readers) {
+            reader.join();
+        }
+        const std::chrono::duration<double> elapsed = Clock::now() - begin;
+        if (writer.joinable()) {
+            writer.join();
+        }
+        return static_cast<double>(total.load()) / elapsed.count();
+    }
+}
+
+int main() {
+    auto& manager = fourdst::plugin::manager::PluginManager::getInstance();
+    manager.load(OTHER_PLUGIN_PATH);
+    manager.load(VALID_PLUGIN_PATH);
+
+    const unsigned max_threads = std::max(1u, std::thread::hardware_concurrency());
+    std::printf("%8s %20s %20s\n", "threads", "lookups/s (idle)", "lookups/s (churn)");
+    for (unsigned threads = 1; threads <= max_threads; threads *= 2) {
+        const double idle = measure(manager, threads, false);
+        const double churn = measure(manager, threads, true);
+        std::printf("%8u %20.3e %20.3e\n", threads, idle, churn);
+    }
+    return 0;
+}
@@ -0,0 +1,86 @@
+/**
+ * @file shutdown_time.cpp
+ * @brief Time to tear down a manager holding N plugins, per unload strategy
+ *
+ * Loads N synthetic plugins (default 500, override with argv[1]) into a fresh
+ * manager and tears it down with the destructor, by unloading every plugin
+ * with and without deferred unloading, and with fast_shutdown(). "blocked"
+ * is how long the calling thread is held up;
+ * "closed" is how long until every library has been closed. Each strategy
+ * gets its own copies of the plugins, since fast_shutdown() leaves its
+ * libraries mapped.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "fourdst/plugin/plugin.h"
+#include "fourdst/plugin/bundle/utils.h"
+#include "synthetic.h"
+
+std::atomic<bool> g_destructor_called = false;
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+    using fourdst::plugin::manager::PluginManager;
+
+    std::unique_ptr<PluginManager> load_plugins(const std::vector<std::filesystem::path>& paths) {
+        auto manager = std::make_unique<PluginManager>();
+        const auto report = manager->load_all(paths);
+        if (!report.ok()) {
+            std::fprintf(stderr, "%zu plugins failed to load, first: %s\n", report.failures.size(), report.failures.front().message.c_str());
+            std::exit(1);
+        }
+        return manager;
+    }
+}
+
+int main(int argc, char** argv) {
+    const std::size_t count = fourdst::plugin::benchmarks::count_argument(argc, argv, 500);
+    const fourdst::plugin::bundle::utils::TemporaryDirectory directory;
+    const auto make_copies = [&](const char* subdirectory) {
+        const auto path = directory.get_path() / subdirectory;
+        std::filesystem::create_directory(path);
+        return fourdst::plugin::benchmarks::make_synthetic_plugins(path, count);
+    };
+
+    std::printf("%-28s %14s %14s\n", "strategy", "blocked (ms)", "closed (ms)");
+
+    {
+        auto manager = load_plugins(make_copies("destructor"));
+        const auto begin = Clock::now();
+        manager.reset();
+        const Milliseconds elapsed = Clock::now() - begin;
+        std::printf("%-28s %14.2f %14.2f\n", "~PluginManager", elapsed.count(), elapsed.count());
+    }
+
+    for (const bool deferred : {false, true}) {
+        const auto paths = make_copies(deferred ? "deferred" : "unload");
+        auto manager = load_plugins(paths);
+        manager->set_deferred_unload(deferred);
+        const auto begin = Clock::now();
+        for (const auto& path : paths) {
+            manager->unload(path.stem().string());
+        }
+        const Milliseconds blocked = Clock::now() - begin;
+        manager->flush_unloads();
+        const Milliseconds closed = Clock::now() - begin;
+        std::printf("%-28s %14.2f %14.2f\n", deferred ? "unload() each, deferred" : "unload() each", blocked.count(), closed.count());
+    }
+
+    {
+        auto manager = load_plugins(make_copies("fast"));
+        const auto begin = Clock::now();
+        manager->fast_shutdown();
+        manager.reset();
+        const Milliseconds elapsed = Clock::now() - begin;
+        std::printf("%-28s %14.2f %14s\n", "fast_shutdown()", elapsed.count(), "never");
+    }
+    return 0;
+}
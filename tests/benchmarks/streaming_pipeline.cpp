@@ -0,0 +1,111 @@
+/**
+ * @file streaming_pipeline.cpp
+ * @brief Throughput of the data-processor example's chain, sequential versus streamed
+ *
+ * Runs N series (default 500, override with argv[1]) of 256 points each
+ * through noise_filter -> moving_average -> scale_transform, the plugins of
+ * examples/04-data-processors:
+ * - sequential: Pipeline::run on the calling thread, one series after another
+ * - streaming: StreamingPipeline, one thread per stage
+ * - streaming, 2x smoothing: the same with two replicas of moving_average
+ * and reports the best of a few rounds in series per second, together with
+ * each stage's median latency. Streaming approaches 1 / (slowest stage) given
+ * a core per stage; on fewer cores it only adds hand-off costs.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "fourdst/plugin/plugin.h"
+#include "../../examples/04-data-processors/include/data_interfaces.h"
+#include "synthetic.h"
+
+std::atomic<bool> g_destructor_called = false;
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+    constexpr int kRounds = 3;
+    constexpr std::size_t kPoints = 256;
+
+    DataSeries make_series(const std::size_t seed) {
+        std::vector<DataPoint> points;
+        points.reserve(kPoints);
+        const auto start = std::chrono::system_clock::time_point{};
+        for (std::size_t i = 0; i < kPoints; ++i) {
+            double value = std::sin(static_cast<double>(i + seed) / 8.0) * 3.0;
+            if ((i * 7 + seed) % 41 == 0) {
+                value += 25.0; // Outlier for the noise filter
+            }
+            points.emplace_back(value, start + std::chrono::milliseconds(i), std::map<std::string, std::string>{{"index", std::to_string(i)}});
+        }
+        return DataSeries(std::move(points), "benchmark");
+    }
+
+    template<typename Run>
+    double best_series_per_second(const std::vector<DataSeries>& inputs, Run&& run) {
+        double best = 0.0;
+        for (int round = 0; round < kRounds; ++round) {
+            std::vector<DataSeries> values = inputs;
+            const auto begin = Clock::now();
+            const std::vector<DataSeries> results = run(std::move(values));
+            const std::chrono::duration<double> elapsed = Clock::now() - begin;
+            best = std::max(best, static_cast<double>(results.size()) / elapsed.count());
+            if (results.size() != inputs.size() || results.back().processing_history.size() != 3) {
+                std::printf("(unexpected result)\n");
+            }
+        }
+        return best;
+    }
+}
+
+int main(int argc, char** argv) {
+    const std::size_t count = fourdst::plugin::benchmarks::count_argument(argc, argv, 500);
+    auto& manager = fourdst::plugin::manager::PluginManager::getInstance();
+    manager.load(NOISE_FILTER_PATH);
+    manager.load(MOVING_AVERAGE_PATH);
+    manager.load(SCALE_TRANSFORM_PATH);
+    const std::vector<std::string> stages = {"libnoise_filter", "libmoving_average", "libscale_transform"};
+
+    std::vector<DataSeries> inputs;
+    inputs.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        inputs.push_back(make_series(i));
+    }
+
+    fourdst::plugin::pipeline::Pipeline<DataSeries> sequential_pipeline;
+    for (const auto& stage : stages) {
+        sequential_pipeline.add(manager, stage);
+    }
+    const double sequential = best_series_per_second(inputs, [&](std::vector<DataSeries> values) {
+        for (DataSeries& value : values) {
+            value = sequential_pipeline.run(std::move(value));
+        }
+        return values;
+    });
+
+    const auto streamed = [&](const std::size_t smoothing_replicas) {
+        return best_series_per_second(inputs, [&](std::vector<DataSeries> values) {
+            fourdst::plugin::pipeline::StreamingPipeline<DataSeries> stream;
+            stream.add(manager, stages[0]).add(manager, stages[1], smoothing_replicas).add(manager, stages[2]);
+            return stream.run(std::move(values));
+        });
+    };
+    const double streaming = streamed(1);
+    const double replicated = streamed(2);
+
+    std::printf("%10s %14s %14s %22s   (series/s, %u hardware threads)\n", "series", "sequential", "streaming",
+                "streaming, 2x smoothing", std::thread::hardware_concurrency());
+    std::printf("%10zu %14.0f %14.0f %22.0f\n", count, sequential, streaming, replicated);
+    std::printf("\nMedian stage latency (sequential):\n");
+    for (const auto& stage : sequential_pipeline.timings()) {
+        std::printf("  %-20s %10.1f us\n", stage.name.c_str(),
+                    std::chrono::duration<double, std::micro>(stage.latency.percentile(50)).count());
+    }
+    return 0;
+}
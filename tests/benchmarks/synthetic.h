@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdio>
+#include <cstdlib>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Helpers for benchmarks that need many distinct plugin libraries on disk.
+// Each copy of the synthetic mock plugin names itself after its file stem,
+// so N copies load as N independent plugins. The copy's name is also stamped
+// over the placeholder in its metadata note, keeping the note truthful.
+namespace fourdst::plugin::benchmarks {
+
+    // The size a benchmark runs at: argv[1] if given, default_count otherwise
+    inline std::size_t count_argument(const int argc, char** argv, const std::size_t default_count) {
+        return argc > 1 ? static_cast<std::size_t>(std::strtoul(argv[1], nullptr, 10)) : default_count;
+    }
+
+    inline std::vector<std::filesystem::path> make_synthetic_plugins(const std::filesystem::path& directory, const std::size_t count) {
+        constexpr std::string_view placeholder = "synthetic_XXXXX";
+
+        std::ifstream source(SYNTHETIC_PLUGIN_PATH, std::ios::binary);
+        const std::vector<char> image{std::istreambuf_iterator<char>(source), std::istreambuf_iterator<char>()};
+
+        std::vector<std::filesystem::path> paths;
+        paths.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            char name[32];
+            std::snprintf(name, sizeof(name), "synthetic_%05zu", i);
+            paths.push_back(directory / (std::string(name) + ".so"));
+
+            std::vector<char> copy = image;
+            for (auto it = copy.begin(); (it = std::search(it, copy.end(), placeholder.begin(), placeholder.end())) != copy.end();) {
+                it = std::copy_n(name, placeholder.size(), it);
+            }
+            std::ofstream(paths.back(), std::ios::binary | std::ios::trunc).write(copy.data(), static_cast<std::streamsize>(copy.size()));
+        }
+        return paths;
+    }
+
+}
@@ -1,11 +1,47 @@
 #include "fourdst/plugin/plugin.h"
 #include "mock_interfaces.h"
 
+namespace {
+    ExampleContext transform_one(const ExampleContext& input) {
+        return {input.value * 2, input.threshold + 1.0};
+    }
+
+    void transform_all(const ExampleContext* in, ExampleContext* out, const std::size_t count) {
+        for (std::size_t i = 0; i < count; ++i) {
+            out[i] = transform_one(in[i]);
+        }
+    }
+
+    void transform_in_place(ExampleContext* values, const std::size_t count) {
+        transform_all(values, values, count);
+    }
+
+    constexpr ExampleFunctorTable kFunctorTable{&transform_one, &transform_in_place};
+}
+
 class FunctorPlugin final : public IExampleFunctor {
+    FOURDST_DECLARE_CONCURRENCY(Pure);
     using IExampleFunctor::IExampleFunctor;
     ExampleContext operator()(const ExampleContext& input) const override {
-        return {input.value * 2, input.threshold + 1.0};
+        return transform_one(input);
+    }
+
+    // The batch override runs one inlined loop instead of a virtual call per element
+    void apply(const std::span<const ExampleContext> in, const std::span<ExampleContext> out) const override {
+        check_batch(in, out);
+        transform_all(in.data(), out.data(), in.size());
+    }
+
+    void transform(ExampleContext& value) const override {
+        transform_in_place(&value, 1);
     }
 };
 
-FOURDST_DECLARE_PLUGIN(FunctorPlugin, "FunctorPlugin", "1.0.0");
\ No newline at end of file
+FOURDST_DECLARE_PLUGIN(FunctorPlugin, "FunctorPlugin", "1.0.0");
+FOURDST_DECLARE_FUNCTION_TABLES(kFunctorTable);
+// An extra C entry point next to the factory functions, looked up with PluginManager::get_symbol
+FOURDST_PLUGIN_EXPORT void functor_plugin_double_all(int* values, const std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+        values[i] *= 2;
+    }
+}
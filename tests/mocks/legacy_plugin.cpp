@@ -0,0 +1,40 @@
+#include "fourdst/plugin/plugin.h"
+#include "mock_interfaces.h"
+
+#include <atomic>
+
+// Stands in for a plugin built before interface IDs and concurrency traits existed:
+// it exports the factory pair by hand, without get_plugin_interfaces. Such binaries
+// have no query_interface() or concurrency() slots, so the manager must never call
+// them; this one counts the calls instead, readable through legacy_plugin_queries.
+namespace {
+    std::atomic<int> g_queries{0};
+}
+
+class LegacyPlugin final : public IValidPlugin {
+public:
+    LegacyPlugin() : IValidPlugin("LegacyPlugin", "0.9.0") {}
+    [[nodiscard]] int get_magic_number() const override { return 9; }
+
+    [[nodiscard]] void* query_interface(const fourdst::plugin::interface_id_t id) noexcept override {
+        ++g_queries;
+        return IValidPlugin::query_interface(id);
+    }
+
+    [[nodiscard]] fourdst::plugin::Concurrency concurrency() const noexcept override {
+        ++g_queries;
+        return fourdst::plugin::Concurrency::Pure;
+    }
+};
+
+FOURDST_PLUGIN_EXPORT fourdst::plugin::IPlugin* create_plugin() {
+    return new LegacyPlugin();
+}
+
+FOURDST_PLUGIN_EXPORT void destroy_plugin(fourdst::plugin::IPlugin* plugin) {
+    delete plugin;
+}
+
+FOURDST_PLUGIN_EXPORT int legacy_plugin_queries() {
+    return g_queries.load();
+}
@@ -8,7 +8,9 @@
 
 // A mock interface for the valid plugin to test type-safe casting.
 // It inherits VIRTUALLY from IPlugin to solve the diamond inheritance problem.
+// It declares an interface ID so that get<IValidPlugin>() resolves through query_interface.
 class IValidPlugin : public fourdst::plugin::PluginBase {
+    FOURDST_DECLARE_INTERFACE(IValidPlugin, fourdst::plugin::PluginBase, "fourdst.tests.IValidPlugin");
 public:
     using PluginBase::PluginBase;
 
@@ -32,4 +34,11 @@ struct ExampleContext {
 // A mock functor interface for testing plugin functionality.
 class IExampleFunctor : public fourdst::plugin::templates::FunctorPlugin_T<ExampleContext> {
     using FunctorPlugin_T::FunctorPlugin_T;
-};
\ No newline at end of file
+};
+
+// A function table exported by the functor plugin next to its class, for direct calls.
+struct ExampleFunctorTable {
+    static constexpr fourdst::plugin::interface_id_t table_id = fourdst::plugin::make_interface_id("fourdst.tests.ExampleFunctorTable/1");
+    ExampleContext (*apply)(const ExampleContext& input);
+    void (*apply_all)(ExampleContext* values, std::size_t count);
+};
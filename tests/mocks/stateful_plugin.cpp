@@ -0,0 +1,33 @@
+#include "fourdst/plugin/plugin.h"
+#include "mock_interfaces.h"
+
+#include <array>
+#include <cstddef>
+#include <mutex>
+
+// A functor with per-instance scratch state (a window of recent inputs and a call
+// counter). The shared instance returned by get() must lock around that state;
+// instances owned by one caller (create_instance, get_local, InstancePool) only
+// ever take the lock uncontended. The threshold of the result is the number of
+// calls made on the instance so far.
+class StatefulPlugin final : public IExampleFunctor {
+    FOURDST_DECLARE_CONCURRENCY(Reentrant);
+    using IExampleFunctor::IExampleFunctor;
+    ExampleContext operator()(const ExampleContext& input) const override {
+        std::lock_guard lock(m_mutex);
+        m_window[m_calls % m_window.size()] = input.value;
+        ++m_calls;
+        int sum = 0;
+        for (const int value : m_window) {
+            sum += value;
+        }
+        return {sum, static_cast<double>(m_calls)};
+    }
+
+private:
+    mutable std::mutex m_mutex;
+    mutable std::array<int, 16> m_window{};
+    mutable std::size_t m_calls = 0;
+};
+
+FOURDST_DECLARE_PLUGIN(StatefulPlugin, "StatefulPlugin", "1.0.0");
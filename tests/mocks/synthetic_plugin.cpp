@@ -0,0 +1,31 @@
+#include "fourdst/plugin/plugin.h"
+#include "mock_interfaces.h"
+
+#include <dlfcn.h>
+#include <filesystem>
+#include <string>
+
+// A plugin that names itself after the file it was loaded from. Benchmarks copy
+// this library many times to simulate large plugin directories with unique names,
+// stamping the copy's name over the "synthetic_XXXXX" placeholder in the metadata note.
+namespace {
+    std::string library_stem() {
+        Dl_info info{};
+        if (dladdr(reinterpret_cast<void*>(&library_stem), &info) == 0 || !info.dli_fname) {
+            return "SyntheticPlugin";
+        }
+        return std::filesystem::path(info.dli_fname).stem().string();
+    }
+
+    const std::string g_plugin_name = library_stem();
+
+    // Internal linkage keeps copies loaded with RTLD_GLOBAL from interposing each other's methods.
+    class SyntheticPlugin final : public IValidPlugin {
+    public:
+        using IValidPlugin::IValidPlugin;
+        [[nodiscard]] const char* get_name() const override { return g_plugin_name.c_str(); }
+        [[nodiscard]] int get_magic_number() const override { return 7; }
+    };
+}
+
+FOURDST_DECLARE_PLUGIN(SyntheticPlugin, "synthetic_XXXXX", "1.0.0");
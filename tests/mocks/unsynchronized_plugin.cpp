@@ -0,0 +1,31 @@
+#include "fourdst/plugin/plugin.h"
+#include "mock_interfaces.h"
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+
+// A functor with per-instance state and no locking, declared PerThreadInstance:
+// executors must give every thread an instance of its own or serialize the calls.
+// Overlapping calls on one instance are detected and reported by throwing. The
+// threshold of the result is the number of calls made on the instance so far.
+class UnsynchronizedPlugin final : public IExampleFunctor {
+    FOURDST_DECLARE_CONCURRENCY(PerThreadInstance);
+    using IExampleFunctor::IExampleFunctor;
+
+    ExampleContext operator()(const ExampleContext& input) const override {
+        if (m_in_call.exchange(true, std::memory_order_acquire)) {
+            throw std::logic_error("UnsynchronizedPlugin: overlapping calls on one instance");
+        }
+        ++m_calls;
+        const ExampleContext result{input.value * 2, static_cast<double>(m_calls)};
+        m_in_call.store(false, std::memory_order_release);
+        return result;
+    }
+
+private:
+    mutable std::atomic<bool> m_in_call{false};
+    mutable std::size_t m_calls = 0;
+};
+
+FOURDST_DECLARE_PLUGIN(UnsynchronizedPlugin, "UnsynchronizedPlugin", "1.0.0");
@@ -0,0 +1,36 @@
+#include "fourdst/plugin/plugin.h"
+#include "mock_interfaces.h"
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+// This global is defined in the test executable that loads this plugin.
+extern std::atomic<bool> g_warmup_should_fail;
+
+// A functor with a slow warm-up step. The value of the result is 1 once the
+// plugin has been warmed and its threshold is the number of warm-ups run.
+class WarmupPlugin final : public IExampleFunctor {
+public:
+    using IExampleFunctor::IExampleFunctor;
+    ExampleContext operator()(const ExampleContext&) const override {
+        return {m_warm.load() ? 1 : 0, static_cast<double>(m_warmups.load())};
+    }
+
+    void warmup() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        ++m_warmups;
+        if (g_warmup_should_fail) {
+            throw std::runtime_error("warm-up failed");
+        }
+        m_warm = true;
+    }
+
+private:
+    std::atomic<bool> m_warm = false;
+    std::atomic<int> m_warmups = 0;
+};
+
+FOURDST_DECLARE_PLUGIN(WarmupPlugin, "WarmupPlugin", "1.0.0");
+FOURDST_DECLARE_PLUGIN_WARMUP(WarmupPlugin);
@@ -0,0 +1,369 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <filesystem>
+#include <thread>
+#include <vector>
+
+#include "fourdst/plugin/plugin.h"
+#include "mocks/mock_interfaces.h"
+
+// The valid mock plugin flags its destruction through this symbol.
+std::atomic<bool> g_destructor_called = false;
+
+namespace {
+    constexpr int kReaderThreads = 16;
+    constexpr int kWriterIterations = 200;
+}
+
+// Test Fixture for concurrent PluginManager access
+class PluginManagerConcurrencyTest : public ::testing::Test {
+protected:
+    fourdst::plugin::manager::PluginManager& manager = fourdst::plugin::manager::PluginManager::getInstance();
+    std::filesystem::path valid_plugin_path;
+    std::filesystem::path other_plugin_path;
+    std::filesystem::path functor_plugin_path;
+
+    void SetUp() override {
+        #ifdef VALID_PLUGIN_PATH
+            valid_plugin_path = VALID_PLUGIN_PATH;
+        #endif
+        #ifdef OTHER_PLUGIN_PATH
+            other_plugin_path = OTHER_PLUGIN_PATH;
+        #endif
+        #ifdef FUNCTOR_PLUGIN_PATH
+            functor_plugin_path = FUNCTOR_PLUGIN_PATH;
+        #endif
+    }
+
+    void TearDown() override {
+        manager.unload("ValidPlugin");
+        manager.unload("OtherPlugin");
+        manager.unload("FunctorPlugin");
+        manager.unload("StatefulPlugin");
+    }
+};
+
+TEST_F(PluginManagerConcurrencyTest, ConcurrentLookupsDuringLoadAndUnload) {
+    // OtherPlugin stays loaded for the whole test so readers can safely dereference it.
+    manager.load(other_plugin_path);
+
+    std::atomic<bool> stop = false;
+    std::atomic<long> stable_hits = 0;
+    std::atomic<long> churn_hits = 0;
+    std::atomic<long> churn_misses = 0;
+
+    std::vector<std::thread> readers;
+    readers.reserve(kReaderThreads);
+    for (int i = 0; i < kReaderThreads; ++i) {
+        readers.emplace_back([&] {
+            while (!stop.load(std::memory_order_relaxed)) {
+                auto* stable = manager.get<IOtherInterface>("OtherPlugin");
+                if (std::string_view(stable->get_name()) == "OtherPlugin") {
+                    stable_hits.fetch_add(1, std::memory_order_relaxed);
+                }
+
+                // The churned plugins are only probed, never dereferenced: unload may race with us.
+                try {
+                    (void)manager.get<fourdst::plugin::IPlugin>("ValidPlugin");
+                    churn_hits.fetch_add(1, std::memory_order_relaxed);
+                } catch (const fourdst::plugin::exception::PluginNotLoadedError&) {
+                    churn_misses.fetch_add(1, std::memory_order_relaxed);
+                }
+                (void)manager.has("FunctorPlugin");
+            }
+        });
+    }
+
+    std::thread writer([&] {
+        for (int i = 0; i < kWriterIterations; ++i) {
+            manager.load(valid_plugin_path);
+            manager.load(functor_plugin_path);
+            manager.unload("ValidPlugin");
+            manager.unload("FunctorPlugin");
+        }
+        stop = true;
+    });
+
+    writer.join();
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    EXPECT_GT(stable_hits.load(), 0);
+    EXPECT_GT(churn_hits.load() + churn_misses.load(), 0);
+    EXPECT_TRUE(manager.has("OtherPlugin"));
+    EXPECT_FALSE(manager.has("ValidPlugin"));
+    EXPECT_FALSE(manager.has("FunctorPlugin"));
+}
+
+TEST_F(PluginManagerConcurrencyTest, ConcurrentWritersNeverDoubleLoad) {
+    std::atomic<int> loaded = 0;
+    std::atomic<int> collisions = 0;
+
+    std::vector<std::thread> writers;
+    for (int i = 0; i < 8; ++i) {
+        writers.emplace_back([&] {
+            try {
+                manager.load(valid_plugin_path);
+                loaded.fetch_add(1);
+            } catch (const fourdst::plugin::exception::PluginNameCollisionError&) {
+                collisions.fetch_add(1);
+            }
+        });
+    }
+    for (auto& writer : writers) {
+        writer.join();
+    }
+
+    EXPECT_EQ(loaded.load(), 1);
+    EXPECT_EQ(collisions.load(), 7);
+    EXPECT_EQ(manager.get<IValidPlugin>("ValidPlugin")->get_magic_number(), 42);
+}
+
+TEST_F(PluginManagerConcurrencyTest, UnloadWaitsForNoReaderAndDestroysPlugin) {
+    manager.load(valid_plugin_path);
+    g_destructor_called = false;
+
+    std::atomic<bool> stop = false;
+    std::vector<std::thread> readers;
+    for (int i = 0; i < kReaderThreads; ++i) {
+        readers.emplace_back([&] {
+            while (!stop.load(std::memory_order_relaxed)) {
+                (void)manager.has("ValidPlugin");
+            }
+        });
+    }
+
+    manager.unload("ValidPlugin");
+    EXPECT_TRUE(g_destructor_called);
+
+    stop = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    EXPECT_FALSE(manager.has("ValidPlugin"));
+}
+
+TEST_F(PluginManagerConcurrencyTest, LazyPluginIsLoadedOnceUnderConcurrentFirstAccess) {
+    manager.register_lazy(valid_plugin_path, "ValidPlugin");
+
+    std::atomic<bool> go = false;
+    std::vector<IValidPlugin*> seen(kReaderThreads, nullptr);
+    std::vector<std::thread> readers;
+    for (int i = 0; i < kReaderThreads; ++i) {
+        readers.emplace_back([&, i] {
+            while (!go.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            seen[i] = manager.get<IValidPlugin>("ValidPlugin");
+        });
+    }
+    go = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    for (IValidPlugin* plugin : seen) {
+        EXPECT_EQ(plugin, seen.front());
+    }
+    EXPECT_EQ(seen.front()->get_magic_number(), 42);
+}
+
+TEST_F(PluginManagerConcurrencyTest, PinnedFirstAccessNeverDeadlocksWithUnpinnedOne) {
+    constexpr int kRounds = 50;
+    for (int round = 0; round < kRounds; ++round) {
+        fourdst::plugin::manager::PluginManager tenant;
+        tenant.register_lazy(valid_plugin_path, "ValidPlugin");
+
+        // The unpinned loader waits for the pinned reader's epoch; the pinned reader
+        // may meanwhile wait for the load to finish. Neither may wait on the other.
+        std::atomic<int> ready = 0;
+        IValidPlugin* seen_pinned = nullptr;
+        IValidPlugin* seen_unpinned = nullptr;
+        std::thread pinned([&] {
+            const auto guard = tenant.pin();
+            ++ready;
+            while (ready.load() < 2) {
+                std::this_thread::yield();
+            }
+            seen_pinned = tenant.get<IValidPlugin>("ValidPlugin");
+        });
+        std::thread unpinned([&] {
+            ++ready;
+            while (ready.load() < 2) {
+                std::this_thread::yield();
+            }
+            seen_unpinned = tenant.get<IValidPlugin>("ValidPlugin");
+        });
+        pinned.join();
+        unpinned.join();
+
+        ASSERT_NE(seen_pinned, nullptr);
+        EXPECT_EQ(seen_pinned, seen_unpinned);
+    }
+}
+
+TEST_F(PluginManagerConcurrencyTest, ReloadNeverLeavesAGapForPinnedReaders) {
+    manager.load(valid_plugin_path);
+
+    std::atomic<bool> stop = false;
+    std::atomic<long> hits = 0;
+    std::atomic<long> misses = 0;
+    std::vector<std::thread> readers;
+    for (int i = 0; i < kReaderThreads; ++i) {
+        readers.emplace_back([&] {
+            while (!stop.load(std::memory_order_relaxed)) {
+                const auto guard = manager.pin();
+                try {
+                    if (manager.get<IValidPlugin>("ValidPlugin")->get_magic_number() == 42) {
+                        hits.fetch_add(1, std::memory_order_relaxed);
+                    }
+                } catch (const fourdst::plugin::exception::PluginNotLoadedError&) {
+                    misses.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+
+    while (hits.load() == 0) {
+        std::this_thread::yield();
+    }
+    for (int i = 0; i < kWriterIterations; ++i) {
+        manager.reload("ValidPlugin", valid_plugin_path);
+    }
+    stop = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    EXPECT_GT(hits.load(), 0);
+    EXPECT_EQ(misses.load(), 0);
+}
+
+TEST_F(PluginManagerConcurrencyTest, ThreadLocalAndPooledInstancesAreNeverShared) {
+    constexpr int kCalls = 1000;
+    manager.load(STATEFUL_PLUGIN_PATH);
+    fourdst::plugin::manager::InstancePool<IExampleFunctor> pool(manager, "StatefulPlugin");
+
+    std::atomic<int> shared_local = 0;
+    std::atomic<int> shared_pooled = 0;
+    std::vector<std::thread> workers;
+    for (int i = 0; i < kReaderThreads; ++i) {
+        workers.emplace_back([&] {
+            auto* local = manager.get_local<IExampleFunctor>("StatefulPlugin");
+            const double before = (*local)(ExampleContext{1, 0.0}).threshold;
+            for (int call = 1; call < kCalls; ++call) {
+                (void)(*local)(ExampleContext{1, 0.0});
+            }
+            // Another thread calling into this instance would have advanced its counter
+            if ((*local)(ExampleContext{1, 0.0}).threshold != before + kCalls) {
+                shared_local.fetch_add(1);
+            }
+
+            for (int round = 0; round < 10; ++round) {
+                auto lease = pool.checkout();
+                const double start = (*lease)(ExampleContext{1, 0.0}).threshold;
+                for (int call = 0; call < 100; ++call) {
+                    (void)(*lease)(ExampleContext{1, 0.0});
+                }
+                if ((*lease)(ExampleContext{1, 0.0}).threshold != start + 101) {
+                    shared_pooled.fetch_add(1);
+                }
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    EXPECT_EQ(shared_local.load(), 0);
+    EXPECT_EQ(shared_pooled.load(), 0);
+    EXPECT_GE(pool.idle(), 1);
+}
+
+TEST_F(PluginManagerConcurrencyTest, PinnedReadersDoNotHoldUpOtherManagers) {
+    fourdst::plugin::manager::PluginManager tenant;
+    tenant.load(valid_plugin_path);
+    manager.load(other_plugin_path);
+    g_destructor_called = false;
+
+    std::atomic<bool> pinned = false;
+    std::atomic<bool> release = false;
+    std::thread reader([&] {
+        const auto guard = manager.pin();
+        (void)manager.get<IOtherInterface>("OtherPlugin");
+        pinned = true;
+        while (!release.load()) {
+            std::this_thread::yield();
+        }
+    });
+    while (!pinned.load()) {
+        std::this_thread::yield();
+    }
+
+    // Would wait for the reader forever if both managers shared their reader epochs
+    tenant.unload("ValidPlugin");
+    EXPECT_TRUE(g_destructor_called);
+
+    release = true;
+    reader.join();
+}
+
+TEST_F(PluginManagerConcurrencyTest, ProfiledCallsFromManyThreadsAreAllCounted) {
+    constexpr int kThreads = 8;
+    constexpr int kCalls = 5000;
+    manager.load(functor_plugin_path);
+    fourdst::plugin::templates::ProfiledFunctor<ExampleContext> profiled(*manager.get<IExampleFunctor>("FunctorPlugin"));
+
+    std::atomic<bool> stop = false;
+    std::atomic<std::uint64_t> snapshots = 0;
+    std::thread reader([&] {
+        std::uint64_t previous = 0;
+        while (!stop.load()) {
+            const std::uint64_t count = profiled.latency().count();
+            EXPECT_GE(count, previous);
+            previous = count;
+            snapshots.fetch_add(1);
+        }
+    });
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < kThreads; ++t) {
+        workers.emplace_back([&] {
+            for (int call = 0; call < kCalls; ++call) {
+                (void)profiled(ExampleContext{call, 0.0});
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    stop = true;
+    reader.join();
+
+    EXPECT_EQ(profiled.latency().count(), static_cast<std::uint64_t>(kThreads) * kCalls);
+    EXPECT_GE(snapshots.load(), 1u);
+}
+
+TEST_F(PluginManagerConcurrencyTest, TracedSpansFromManyThreadsAreWrittenOrCounted) {
+    constexpr int kThreads = 8;
+    constexpr int kSpans = 2000;
+    const std::filesystem::path trace_path = std::filesystem::temp_directory_path() / "fourdst_concurrency.trace.json";
+    fourdst::plugin::profile::Tracer::start(trace_path, {.ring_capacity = 256, .flush_interval = std::chrono::milliseconds(1)});
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < kThreads; ++t) {
+        workers.emplace_back([] {
+            for (int span = 0; span < kSpans; ++span) {
+                fourdst::plugin::profile::TraceSpan traced("test", "span", "worker");
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    const auto summary = fourdst::plugin::profile::Tracer::stop();
+    EXPECT_EQ(summary.written + summary.dropped, static_cast<std::uint64_t>(kThreads) * kSpans);
+    std::filesystem::remove(trace_path);
+}
@@ -2,12 +2,18 @@
 #include <filesystem>
 #include <fstream>
 #include <atomic>
+#include <chrono>
+#include <thread>
+#include <dlfcn.h>
 
 #include "fourdst/plugin/plugin.h"
+#include "fourdst/plugin/bundle/bundle.h"
+#include "fourdst/plugin/bundle/utils.h"
 #include "mocks/mock_interfaces.h"
 
 // DEFINE the global variable here, in the test executable's compilation unit.
 std::atomic<bool> g_destructor_called = false;
+std::atomic<bool> g_warmup_should_fail = false;
 
 // Test Fixture for PluginManager tests
 class PluginManagerTest : public ::testing::Test {
@@ -129,3 +135,1192 @@ TEST_F(PluginManagerTest, R5_3_FunctorPluginWorksAsExpected) {
     EXPECT_EQ(value, 84);
     EXPECT_DOUBLE_EQ(threshold, 4.14);
 }
+
+// --- R6: Typed Plugin Handles ---
+
+TEST_F(PluginManagerTest, R6_1_ResolvedHandleDereferencesToPlugin) {
+    auto handle = manager.resolve<IValidPlugin>("ValidPlugin");
+    ASSERT_TRUE(handle.is_valid());
+    EXPECT_EQ(handle->get_magic_number(), 42);
+    EXPECT_EQ(handle.get(), manager.get<IValidPlugin>("ValidPlugin"));
+}
+
+TEST_F(PluginManagerTest, R6_2_HandleIsStaleAfterUnloadAndReload) {
+    auto handle = manager.resolve<IValidPlugin>("ValidPlugin");
+    manager.unload("ValidPlugin");
+    EXPECT_FALSE(handle.is_valid());
+    EXPECT_THROW((void)handle.checked_get(), fourdst::plugin::exception::PluginNotLoadedError);
+
+    manager.load(valid_plugin_path);
+    auto fresh_handle = manager.resolve<IValidPlugin>("ValidPlugin");
+    EXPECT_TRUE(fresh_handle.is_valid());
+    EXPECT_FALSE(handle.is_valid());
+    EXPECT_GT(fresh_handle.generation(), handle.generation());
+}
+
+TEST_F(PluginManagerTest, R6_3_ResolveThrowsLikeGet) {
+    EXPECT_THROW(manager.resolve<fourdst::plugin::IPlugin>("NonExistentPlugin"), fourdst::plugin::exception::PluginNotLoadedError);
+    EXPECT_THROW(manager.resolve<IValidPlugin>("OtherPlugin"), fourdst::plugin::exception::PluginTypeError);
+    EXPECT_FALSE(fourdst::plugin::manager::PluginHandle<IValidPlugin>{}.is_valid());
+}
+
+// --- R7: Interface IDs ---
+
+TEST_F(PluginManagerTest, R7_1_DeclaredInterfaceAnswersQueryInterface) {
+    static_assert(fourdst::plugin::DeclaresInterfaceId<IValidPlugin>);
+    static_assert(!fourdst::plugin::DeclaresInterfaceId<IOtherInterface>);
+    static_assert(IValidPlugin::interface_id == fourdst::plugin::make_interface_id("fourdst.tests.IValidPlugin"));
+
+    auto* valid = manager.get<fourdst::plugin::IPlugin>("ValidPlugin");
+    EXPECT_EQ(valid->query_interface(IValidPlugin::interface_id), static_cast<void*>(dynamic_cast<IValidPlugin*>(valid)));
+
+    auto* other = manager.get<fourdst::plugin::IPlugin>("OtherPlugin");
+    EXPECT_EQ(other->query_interface(IValidPlugin::interface_id), nullptr);
+}
+
+TEST_F(PluginManagerTest, R7_2_GetUsesInterfaceIdAndFallsBackToDynamicCast) {
+    EXPECT_EQ(manager.get<IValidPlugin>("ValidPlugin")->get_magic_number(), 42);
+    EXPECT_NE(manager.get<IOtherInterface>("OtherPlugin"), nullptr);
+    EXPECT_THROW(manager.get<IValidPlugin>("OtherPlugin"), fourdst::plugin::exception::PluginTypeError);
+}
+
+// --- R8: Interface Enumeration ---
+
+TEST_F(PluginManagerTest, R8_1_FindAllReturnsOnlyMatchingPlugins) {
+    const auto valid_plugins = manager.find_all<IValidPlugin>();
+    ASSERT_EQ(valid_plugins.size(), 1);
+    EXPECT_EQ(valid_plugins[0], manager.get<IValidPlugin>("ValidPlugin"));
+
+    const auto functors = manager.find_all<IExampleFunctor>();
+    ASSERT_EQ(functors.size(), 1);
+    EXPECT_STREQ(functors[0]->get_name(), "FunctorPlugin");
+
+    EXPECT_EQ(manager.find_all<fourdst::plugin::IPlugin>().size(), 3);
+}
+
+TEST_F(PluginManagerTest, R8_2_LoadedPluginsReportTheirInterfaces) {
+    void* handle = dlopen(valid_plugin_path.c_str(), RTLD_LAZY | RTLD_NOLOAD);
+    ASSERT_NE(handle, nullptr);
+    const auto get_interfaces = reinterpret_cast<fourdst::plugin::plugin_interfaces_t>(dlsym(handle, "get_plugin_interfaces"));
+    ASSERT_NE(get_interfaces, nullptr);
+
+    std::size_t count = 0;
+    const fourdst::plugin::interface_id_t* ids = get_interfaces(&count);
+    ASSERT_EQ(count, 1);
+    EXPECT_EQ(ids[0], IValidPlugin::interface_id);
+    dlclose(handle);
+}
+
+TEST_F(PluginManagerTest, R8_3_UnloadedPluginsLeaveTheIndex) {
+    const auto before = manager.find_all<IValidPlugin>();
+    manager.unload("ValidPlugin");
+    EXPECT_TRUE(manager.find_all<IValidPlugin>().empty());
+    EXPECT_EQ(before.size(), 1);
+
+    manager.load(valid_plugin_path);
+    EXPECT_EQ(manager.find_all<IValidPlugin>().size(), 1);
+}
+
+// --- R9: Batch Loading ---
+
+TEST_F(PluginManagerTest, R9_1_LoadAllReportsFailuresWithoutThrowing) {
+    manager.unload("ValidPlugin");
+    manager.unload("OtherPlugin");
+    manager.unload("FunctorPlugin");
+
+    const std::vector<std::filesystem::path> paths = {
+        valid_plugin_path, non_existent_path, other_plugin_path, invalid_lib_path, no_factory_plugin_path, functor_plugin_path
+    };
+    fourdst::plugin::manager::LoadReport report;
+    ASSERT_NO_THROW(report = manager.load_all(paths));
+
+    EXPECT_EQ(report.loaded.size(), 3);
+    EXPECT_TRUE(manager.has("ValidPlugin"));
+    EXPECT_TRUE(manager.has("OtherPlugin"));
+    EXPECT_TRUE(manager.has("FunctorPlugin"));
+
+    ASSERT_EQ(report.failures.size(), 3);
+    EXPECT_FALSE(report.ok());
+    EXPECT_EQ(report.failures[0].path, non_existent_path);
+    EXPECT_THROW(std::rethrow_exception(report.failures[0].error), fourdst::plugin::exception::PluginLoadError);
+    EXPECT_EQ(report.failures[1].path, invalid_lib_path);
+    EXPECT_THROW(std::rethrow_exception(report.failures[1].error), fourdst::plugin::exception::PluginLoadError);
+    EXPECT_EQ(report.failures[2].path, no_factory_plugin_path);
+    EXPECT_THROW(std::rethrow_exception(report.failures[2].error), fourdst::plugin::exception::PluginSymbolError);
+    EXPECT_FALSE(report.failures[2].message.empty());
+}
+
+TEST_F(PluginManagerTest, R9_2_LoadAllRejectsNameCollisions) {
+    const std::vector<std::filesystem::path> paths = {valid_plugin_path};
+    const auto report = manager.load_all(paths);
+    EXPECT_TRUE(report.loaded.empty());
+    ASSERT_EQ(report.failures.size(), 1);
+    EXPECT_THROW(std::rethrow_exception(report.failures[0].error), fourdst::plugin::exception::PluginNameCollisionError);
+    EXPECT_EQ(manager.get<IValidPlugin>("ValidPlugin")->get_magic_number(), 42);
+}
+
+TEST_F(PluginManagerTest, R9_3_FailedLibraryDoesNotClaimItsName) {
+    manager.unload("ValidPlugin");
+
+    // A copy of ValidPlugin for another machine: its note still reads, but dlopen refuses it
+    const auto foreign_path = std::filesystem::temp_directory_path() / "foreign_valid_plugin.so";
+    std::filesystem::copy_file(valid_plugin_path, foreign_path, std::filesystem::copy_options::overwrite_existing);
+    {
+        std::fstream file(foreign_path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(18); // e_machine
+        const char machine[2] = {'\xff', '\x7f'};
+        file.write(machine, sizeof(machine));
+    }
+    ASSERT_TRUE(fourdst::plugin::inspect(foreign_path).has_value());
+
+    const std::vector<std::filesystem::path> paths = {foreign_path, valid_plugin_path};
+    const auto report = manager.load_all(paths);
+    ASSERT_EQ(report.failures.size(), 1);
+    EXPECT_EQ(report.failures[0].path, foreign_path);
+    EXPECT_THROW(std::rethrow_exception(report.failures[0].error), fourdst::plugin::exception::PluginLoadError);
+    ASSERT_EQ(report.loaded.size(), 1);
+    EXPECT_EQ(manager.get<IValidPlugin>("ValidPlugin")->get_magic_number(), 42);
+    std::filesystem::remove(foreign_path);
+}
+
+// --- R10: Lazy Registration ---
+
+namespace {
+    bool library_is_mapped(const std::filesystem::path& path) {
+        void* handle = dlopen(path.c_str(), RTLD_LAZY | RTLD_NOLOAD);
+        if (handle) {
+            dlclose(handle);
+        }
+        return handle != nullptr;
+    }
+}
+
+TEST_F(PluginManagerTest, R10_1_LazyPluginIsOpenedOnFirstAccess) {
+    // A fresh copy of the synthetic plugin (named after its file) has never been mapped
+    const auto lazy_path = std::filesystem::temp_directory_path() / "lazy_synthetic.so";
+    std::filesystem::copy_file(SYNTHETIC_PLUGIN_PATH, lazy_path, std::filesystem::copy_options::overwrite_existing);
+
+    manager.register_lazy(lazy_path, "lazy_synthetic");
+    EXPECT_FALSE(library_is_mapped(lazy_path));
+    EXPECT_EQ(manager.find_all<IValidPlugin>().size(), 1);
+    EXPECT_THROW(manager.load(lazy_path), fourdst::plugin::exception::PluginNameCollisionError);
+    EXPECT_THROW(manager.register_lazy(lazy_path, "lazy_synthetic"), fourdst::plugin::exception::PluginNameCollisionError);
+    EXPECT_THROW(manager.register_lazy(valid_plugin_path, "ValidPlugin"), fourdst::plugin::exception::PluginNameCollisionError);
+
+    EXPECT_TRUE(manager.has("lazy_synthetic"));
+    EXPECT_TRUE(library_is_mapped(lazy_path));
+    auto* plugin = manager.get<IValidPlugin>("lazy_synthetic");
+    EXPECT_EQ(plugin->get_magic_number(), 7);
+    EXPECT_EQ(manager.get<IValidPlugin>("lazy_synthetic"), plugin);
+    EXPECT_EQ(manager.find_all<IValidPlugin>().size(), 2);
+
+    manager.unload("lazy_synthetic");
+    EXPECT_FALSE(manager.has("lazy_synthetic"));
+    std::filesystem::remove(lazy_path);
+}
+
+TEST_F(PluginManagerTest, R10_2_IdlePluginsAreEvictedAndReloadedOnAccess) {
+    manager.unload("ValidPlugin");
+    manager.register_lazy(valid_plugin_path, "ValidPlugin");
+    auto handle = manager.resolve<IValidPlugin>("ValidPlugin");
+    g_destructor_called = false;
+
+    EXPECT_EQ(manager.evict_idle(std::chrono::hours(1)), 0);
+    EXPECT_TRUE(handle.is_valid());
+
+    // Only the lazily loaded plugin is evicted; eager plugins are never touched
+    EXPECT_EQ(manager.evict_idle(std::chrono::steady_clock::duration::zero()), 1);
+    EXPECT_TRUE(g_destructor_called);
+    EXPECT_FALSE(handle.is_valid());
+    EXPECT_TRUE(manager.has("OtherPlugin"));
+
+    handle = manager.resolve<IValidPlugin>("ValidPlugin");
+    EXPECT_EQ(handle->get_magic_number(), 42);
+
+    manager.set_idle_eviction(std::chrono::milliseconds(10));
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (handle.is_valid() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    manager.set_idle_eviction(std::chrono::milliseconds::zero());
+    EXPECT_FALSE(handle.is_valid());
+    EXPECT_TRUE(manager.has("ValidPlugin"));
+}
+
+TEST_F(PluginManagerTest, R10_3_LazyRegistrationReportsLoadErrorsOnAccess) {
+    manager.register_lazy(functor_plugin_path, "NotTheFunctorPlugin");
+    EXPECT_FALSE(manager.has("NotTheFunctorPlugin"));
+    EXPECT_THROW(manager.get<fourdst::plugin::IPlugin>("NotTheFunctorPlugin"), fourdst::plugin::exception::PluginLoadError);
+    manager.unload("NotTheFunctorPlugin");
+
+    manager.register_lazy(non_existent_path, "MissingPlugin");
+    EXPECT_THROW(manager.resolve<IValidPlugin>("MissingPlugin"), fourdst::plugin::exception::PluginLoadError);
+    manager.unload("MissingPlugin");
+    EXPECT_THROW(manager.get<IValidPlugin>("MissingPlugin"), fourdst::plugin::exception::PluginNotLoadedError);
+
+    // Unloading a lazy plugin drops its registration; leave ValidPlugin eagerly loaded
+    manager.unload("ValidPlugin");
+    EXPECT_FALSE(manager.has("ValidPlugin"));
+    manager.load(valid_plugin_path);
+    EXPECT_TRUE(manager.has("ValidPlugin"));
+}
+
+// --- R11: Plugin Metadata Notes ---
+
+TEST_F(PluginManagerTest, R11_1_InspectReadsMetadataWithoutLoading) {
+    const auto metadata = fourdst::plugin::inspect(valid_plugin_path);
+    ASSERT_TRUE(metadata.has_value());
+    EXPECT_EQ(metadata->name, "ValidPlugin");
+    EXPECT_EQ(metadata->version, "1.0.0");
+    EXPECT_EQ(metadata->abi_version, fourdst::plugin::note::kPluginNoteAbiVersion);
+    ASSERT_EQ(metadata->interface_ids.size(), 1);
+    EXPECT_EQ(metadata->interface_ids[0], IValidPlugin::interface_id);
+
+    EXPECT_FALSE(fourdst::plugin::inspect(non_existent_path).has_value());
+    EXPECT_FALSE(fourdst::plugin::inspect(invalid_lib_path).has_value());
+    EXPECT_FALSE(fourdst::plugin::inspect(no_factory_plugin_path).has_value());
+}
+
+TEST_F(PluginManagerTest, R11_2_CollisionsAreRejectedBeforeInstantiation) {
+    // A duplicate that got instantiated would be destroyed again, flagging the destructor
+    g_destructor_called = false;
+    EXPECT_THROW(manager.load(valid_plugin_path), fourdst::plugin::exception::PluginNameCollisionError);
+
+    const std::vector<std::filesystem::path> paths = {valid_plugin_path};
+    const auto report = manager.load_all(paths);
+    ASSERT_EQ(report.failures.size(), 1);
+    EXPECT_THROW(std::rethrow_exception(report.failures[0].error), fourdst::plugin::exception::PluginNameCollisionError);
+    EXPECT_FALSE(g_destructor_called);
+}
+
+TEST_F(PluginManagerTest, R11_3_LazyRegistrationCanUseTheNoteName) {
+    EXPECT_THROW(manager.register_lazy(no_factory_plugin_path), fourdst::plugin::exception::PluginLoadError);
+    EXPECT_THROW(manager.register_lazy(other_plugin_path), fourdst::plugin::exception::PluginNameCollisionError);
+
+    manager.unload("OtherPlugin");
+    manager.register_lazy(other_plugin_path);
+    EXPECT_TRUE(manager.has("OtherPlugin"));
+    EXPECT_STREQ(manager.get<IOtherInterface>("OtherPlugin")->get_name(), "OtherPlugin");
+
+    manager.unload("OtherPlugin");
+    manager.load(other_plugin_path);
+}
+
+// --- R12: Plugin Catalogs ---
+
+TEST_F(PluginManagerTest, R12_1_ScanCatalogsDirectoryAndReusesIndex) {
+    const fourdst::plugin::bundle::utils::TemporaryDirectory directory;
+    const auto& dir = directory.get_path();
+    std::filesystem::copy_file(other_plugin_path, dir / "other.so");
+    std::filesystem::copy_file(invalid_lib_path, dir / "broken.so");
+    std::filesystem::copy_file(invalid_lib_path, dir / "notes.txt");
+
+    const auto cold = fourdst::plugin::scan_directory(dir);
+    ASSERT_EQ(cold.entries.size(), 2);
+    EXPECT_EQ(cold.inspected, 2);
+    EXPECT_EQ(cold.cached, 0);
+    EXPECT_EQ(cold.entries[0].path, dir / "broken.so");
+    EXPECT_FALSE(cold.entries[0].metadata.has_value());
+    const auto* other = cold.find("OtherPlugin");
+    ASSERT_NE(other, nullptr);
+    EXPECT_EQ(other->path, dir / "other.so");
+    EXPECT_EQ(other->metadata->version, "1.0.0");
+    EXPECT_TRUE(std::filesystem::exists(dir / fourdst::plugin::kCatalogFileName));
+
+    const auto warm = fourdst::plugin::scan_directory(dir);
+    EXPECT_EQ(warm.inspected, 0);
+    EXPECT_EQ(warm.cached, 2);
+    ASSERT_NE(warm.find("OtherPlugin"), nullptr);
+    EXPECT_EQ(warm.find("OtherPlugin")->metadata->interface_ids, other->metadata->interface_ids);
+
+    std::ofstream(dir / "broken.so", std::ios::app) << "more garbage";
+    const auto modified = fourdst::plugin::scan_directory(dir);
+    EXPECT_EQ(modified.inspected, 1);
+    EXPECT_EQ(modified.cached, 1);
+}
+
+TEST_F(PluginManagerTest, R12_2_ManagerScanRegistersPluginsLazily) {
+    const fourdst::plugin::bundle::utils::TemporaryDirectory directory;
+    const auto& dir = directory.get_path();
+    // The unstamped synthetic plugin is named synthetic_XXXXX, after both its file and its note
+    std::filesystem::copy_file(SYNTHETIC_PLUGIN_PATH, dir / "synthetic_XXXXX.so");
+    std::filesystem::copy_file(other_plugin_path, dir / "other.so");
+
+    const auto catalog = manager.scan(dir);
+    EXPECT_EQ(catalog.entries.size(), 2);
+    EXPECT_EQ(catalog.find("synthetic_XXXXX")->path, dir / "synthetic_XXXXX.so");
+
+    // OtherPlugin was already loaded, so its copy is cataloged but not registered
+    EXPECT_EQ(manager.find_all<IOtherInterface>().size(), 1);
+    EXPECT_TRUE(manager.has("synthetic_XXXXX"));
+    EXPECT_EQ(manager.get<IValidPlugin>("synthetic_XXXXX")->get_magic_number(), 7);
+    manager.unload("synthetic_XXXXX");
+}
+
+// --- R13: Load Options ---
+
+TEST_F(PluginManagerTest, R13_1_LoadOptionsSelectBindingAndScope) {
+    using fourdst::plugin::manager::LoadOptions;
+    manager.unload("FunctorPlugin");
+
+    LoadOptions options;
+    options.binding = LoadOptions::Binding::Now;
+    options.scope = LoadOptions::Scope::Local;
+    options.deep_bind = true;
+    ASSERT_NO_THROW(manager.load(functor_plugin_path, options));
+    auto* functor = manager.get<IExampleFunctor>("FunctorPlugin");
+    EXPECT_EQ((*functor)(ExampleContext{21, 0.0}).value, 42);
+
+    manager.unload("FunctorPlugin");
+    manager.register_lazy(functor_plugin_path, "FunctorPlugin", options);
+    EXPECT_TRUE(manager.has("FunctorPlugin"));
+}
+
+TEST_F(PluginManagerTest, R13_2_NamespaceGroupsIsolatePlugins) {
+    using fourdst::plugin::manager::LoadOptions;
+    const fourdst::plugin::bundle::utils::TemporaryDirectory directory;
+    const auto first = directory.get_path() / "isolated_one.so";
+    const auto second = directory.get_path() / "isolated_two.so";
+    std::filesystem::copy_file(SYNTHETIC_PLUGIN_PATH, first);
+    std::filesystem::copy_file(SYNTHETIC_PLUGIN_PATH, second);
+
+    LoadOptions options;
+    options.namespace_group = "isolated";
+    manager.load(first, options);
+    manager.load(second, options);
+
+    // Neither copy is mapped into the default namespace
+    EXPECT_FALSE(library_is_mapped(first));
+    EXPECT_FALSE(library_is_mapped(second));
+    EXPECT_EQ(manager.get<IValidPlugin>("isolated_one")->get_magic_number(), 7);
+    EXPECT_STREQ(manager.get<IValidPlugin>("isolated_two")->get_name(), "isolated_two");
+
+    manager.unload("isolated_one");
+    manager.unload("isolated_two");
+
+    // The group's namespace is released with its last library and recreated on demand
+    manager.load(first, options);
+    EXPECT_TRUE(manager.has("isolated_one"));
+    manager.unload("isolated_one");
+}
+
+// --- R14: Hot Reload ---
+
+TEST_F(PluginManagerTest, R14_1_ReloadSwapsPluginAndInvalidatesHandles) {
+    if (!manager.has("ValidPlugin")) {
+        manager.load(valid_plugin_path);
+    }
+    auto handle = manager.resolve<IValidPlugin>("ValidPlugin");
+
+    manager.reload("ValidPlugin", valid_plugin_path);
+    EXPECT_TRUE(manager.has("ValidPlugin"));
+    EXPECT_FALSE(handle.is_valid());
+    auto fresh_handle = manager.resolve<IValidPlugin>("ValidPlugin");
+    EXPECT_GT(fresh_handle.generation(), handle.generation());
+    EXPECT_EQ(fresh_handle->get_magic_number(), 42);
+    EXPECT_EQ(manager.find_all<IValidPlugin>().size(), 1);
+
+    // The old plugin stays in place when the replacement is unusable
+    EXPECT_THROW(manager.reload("ValidPlugin", other_plugin_path), fourdst::plugin::exception::PluginLoadError);
+    EXPECT_THROW(manager.reload("ValidPlugin", non_existent_path), fourdst::plugin::exception::PluginLoadError);
+    EXPECT_TRUE(fresh_handle.is_valid());
+    EXPECT_THROW(manager.reload("NonExistentPlugin", valid_plugin_path), fourdst::plugin::exception::PluginNotLoadedError);
+}
+
+TEST_F(PluginManagerTest, R14_2_PinnedReadersKeepReplacedPluginAlive) {
+    if (!manager.has("ValidPlugin")) {
+        manager.load(valid_plugin_path);
+    }
+    g_destructor_called = false;
+    {
+        const auto guard = manager.pin();
+        auto* old_plugin = manager.get<IValidPlugin>("ValidPlugin");
+
+        manager.reload("ValidPlugin", valid_plugin_path);
+        EXPECT_FALSE(g_destructor_called);
+        EXPECT_EQ(old_plugin->get_magic_number(), 42);
+        EXPECT_EQ(manager.get<IValidPlugin>("ValidPlugin")->get_magic_number(), 42);
+    }
+    EXPECT_TRUE(g_destructor_called);
+}
+
+// --- R15: Plugin Instances ---
+
+TEST_F(PluginManagerTest, R15_1_CreateInstanceReturnsIndependentInstances) {
+    manager.load(STATEFUL_PLUGIN_PATH);
+    constexpr ExampleContext input{1, 0.0};
+
+    auto first = manager.create_instance<IExampleFunctor>("StatefulPlugin");
+    auto second = manager.create_instance<IExampleFunctor>("StatefulPlugin");
+    auto* shared = manager.get<IExampleFunctor>("StatefulPlugin");
+    ASSERT_NE(first.get(), second.get());
+    ASSERT_NE(first.get(), shared);
+    (void)(*first)(input);
+    EXPECT_EQ((*first)(input).threshold, 2.0);
+    EXPECT_EQ((*second)(input).threshold, 1.0);
+    EXPECT_EQ((*shared)(input).threshold, 1.0);
+
+    EXPECT_THROW((void)manager.create_instance<IValidPlugin>("StatefulPlugin"), fourdst::plugin::exception::PluginTypeError);
+
+    // Instances keep their library open after the plugin is unloaded
+    manager.unload("StatefulPlugin");
+    EXPECT_EQ((*first)(input).threshold, 3.0);
+    EXPECT_THROW((void)manager.create_instance<IExampleFunctor>("StatefulPlugin"), fourdst::plugin::exception::PluginNotLoadedError);
+}
+
+TEST_F(PluginManagerTest, R15_2_GetLocalIsPerThreadAndRenewedAfterReload) {
+    manager.load(STATEFUL_PLUGIN_PATH);
+    constexpr ExampleContext input{1, 0.0};
+
+    auto* local = manager.get_local<IExampleFunctor>("StatefulPlugin");
+    EXPECT_EQ(manager.get_local<IExampleFunctor>("StatefulPlugin"), local);
+    EXPECT_NE(local, manager.get<IExampleFunctor>("StatefulPlugin"));
+    (void)(*local)(input);
+
+    IExampleFunctor* other_thread = nullptr;
+    std::thread([&] { other_thread = manager.get_local<IExampleFunctor>("StatefulPlugin"); }).join();
+    EXPECT_NE(other_thread, local);
+
+    manager.reload("StatefulPlugin", STATEFUL_PLUGIN_PATH);
+    auto* renewed = manager.get_local<IExampleFunctor>("StatefulPlugin");
+    EXPECT_EQ((*renewed)(input).threshold, 1.0);
+
+    manager.unload("StatefulPlugin");
+    EXPECT_THROW((void)manager.get_local<IExampleFunctor>("StatefulPlugin"), fourdst::plugin::exception::PluginNotLoadedError);
+}
+
+TEST_F(PluginManagerTest, R15_3_InstancePoolReusesReturnedInstances) {
+    manager.load(STATEFUL_PLUGIN_PATH);
+    constexpr ExampleContext input{1, 0.0};
+    fourdst::plugin::manager::InstancePool<IExampleFunctor> pool(manager, "StatefulPlugin", 1);
+
+    {
+        auto first = pool.checkout();
+        auto second = pool.checkout();
+        ASSERT_NE(first.get(), second.get());
+        (void)(*second)(input);
+        second.release();
+        EXPECT_EQ(pool.idle(), 1);
+    }
+    // Only max_idle instances are kept: the first one returned is handed out again
+    EXPECT_EQ(pool.idle(), 1);
+    {
+        auto lease = pool.checkout();
+        EXPECT_EQ(pool.idle(), 0);
+        EXPECT_EQ((*lease)(input).threshold, 2.0);
+    }
+
+    // Instances of the replaced plugin are dropped instead of handed out
+    manager.reload("StatefulPlugin", STATEFUL_PLUGIN_PATH);
+    {
+        auto lease = pool.checkout();
+        EXPECT_EQ((*lease)(input).threshold, 1.0);
+        EXPECT_EQ(pool.idle(), 0);
+    }
+    EXPECT_EQ(pool.idle(), 1);
+    pool.clear();
+    EXPECT_EQ(pool.idle(), 0);
+    manager.unload("StatefulPlugin");
+}
+
+// --- R16: Independent Managers ---
+
+TEST_F(PluginManagerTest, R16_1_ManagersHaveSeparateRegistries) {
+    fourdst::plugin::manager::PluginManager tenant_a;
+    fourdst::plugin::manager::PluginManager tenant_b;
+    EXPECT_NE(&tenant_a, &manager);
+
+    tenant_a.load(STATEFUL_PLUGIN_PATH);
+    EXPECT_NO_THROW(tenant_b.load(STATEFUL_PLUGIN_PATH));
+    EXPECT_FALSE(manager.has("StatefulPlugin"));
+
+    auto* in_a = tenant_a.get<IExampleFunctor>("StatefulPlugin");
+    auto* in_b = tenant_b.get<IExampleFunctor>("StatefulPlugin");
+    EXPECT_NE(in_a, in_b);
+    EXPECT_NE(tenant_a.get_local<IExampleFunctor>("StatefulPlugin"), tenant_b.get_local<IExampleFunctor>("StatefulPlugin"));
+
+    tenant_a.unload("StatefulPlugin");
+    EXPECT_FALSE(tenant_a.has("StatefulPlugin"));
+    EXPECT_EQ((*in_b)(ExampleContext{1, 0.0}).threshold, 1.0);
+}
+
+TEST_F(PluginManagerTest, R16_2_DestroyingAManagerUnloadsItsPlugins) {
+    {
+        fourdst::plugin::manager::PluginManager tenant;
+        tenant.load(valid_plugin_path);
+        g_destructor_called = false;
+    }
+    EXPECT_TRUE(g_destructor_called);
+
+    {
+        fourdst::plugin::manager::PluginManager tenant;
+        tenant.load(valid_plugin_path);
+        EXPECT_EQ(tenant.get_local<IValidPlugin>("ValidPlugin")->get_magic_number(), 42);
+    }
+    g_destructor_called = false; // The thread's own instance outlives the manager for now
+
+    // A new manager starts out empty, even on a thread that used the previous one
+    fourdst::plugin::manager::PluginManager tenant;
+    EXPECT_FALSE(tenant.has("ValidPlugin"));
+    EXPECT_FALSE(g_destructor_called);
+    EXPECT_THROW((void)tenant.get_local<IValidPlugin>("ValidPlugin"), fourdst::plugin::exception::PluginNotLoadedError);
+    EXPECT_TRUE(g_destructor_called) << "get_local must release the instances of destroyed managers";
+}
+
+// --- R17: Load Statistics ---
+
+TEST_F(PluginManagerTest, R17_1_RecordsPhaseTimingsAndMemoryPerPlugin) {
+    fourdst::plugin::manager::PluginManager tenant;
+    tenant.load(valid_plugin_path);
+    EXPECT_TRUE(tenant.load_stats().plugins.empty()) << "Statistics must be off by default";
+
+    tenant.enable_load_stats();
+    tenant.load(functor_plugin_path);
+    const auto stats = tenant.load_stats();
+    ASSERT_EQ(stats.plugins.size(), 1u);
+
+    const auto* functor = stats.find("FunctorPlugin");
+    ASSERT_NE(functor, nullptr);
+    EXPECT_TRUE(functor->loaded);
+    EXPECT_EQ(functor->path, functor_plugin_path);
+    EXPECT_GT(functor->dlopen.count(), 0);
+    EXPECT_GT(functor->create.count(), 0);
+    EXPECT_EQ(functor->total, functor->inspect + functor->stat + functor->dlopen + functor->symbols + functor->create + functor->name_check);
+    EXPECT_GT(functor->mapped_size, 0u);
+    EXPECT_EQ(stats.total(), functor->total);
+}
+
+TEST_F(PluginManagerTest, R17_2_RecordsFailedLoadsAndDumpsJson) {
+    fourdst::plugin::manager::PluginManager tenant;
+    tenant.enable_load_stats();
+    tenant.load(valid_plugin_path);
+    EXPECT_THROW(tenant.load(valid_plugin_path), fourdst::plugin::exception::PluginNameCollisionError);
+    EXPECT_THROW(tenant.load(no_factory_plugin_path), fourdst::plugin::exception::PluginSymbolError);
+
+    const auto stats = tenant.load_stats();
+    ASSERT_EQ(stats.plugins.size(), 3u);
+    EXPECT_TRUE(stats.plugins[0].loaded);
+    EXPECT_FALSE(stats.plugins[1].loaded);
+    EXPECT_FALSE(stats.plugins[1].error.empty());
+    EXPECT_FALSE(stats.plugins[2].loaded);
+    EXPECT_GT(stats.plugins[2].dlopen.count(), 0);
+    EXPECT_EQ(stats.plugins[2].create.count(), 0);
+    EXPECT_EQ(stats.find("ValidPlugin"), &stats.plugins[0]);
+
+    const std::string json = fourdst::plugin::manager::to_json(stats);
+    EXPECT_NE(json.find("\"name\": \"ValidPlugin\""), std::string::npos);
+    EXPECT_NE(json.find("\"dlopen_ns\": "), std::string::npos);
+
+    tenant.clear_load_stats();
+    EXPECT_TRUE(tenant.load_stats().plugins.empty());
+    EXPECT_EQ(fourdst::plugin::manager::to_json(tenant.load_stats()), "{\"plugins\": []}\n");
+}
+
+TEST_F(PluginManagerTest, R17_3_BundleStatsSerializeEveryPhase) {
+    fourdst::plugin::bundle::BundleLoadStats stats;
+    EXPECT_EQ(fourdst::plugin::bundle::to_json(stats),
+              "{\"path\": \"\", \"unzip_ns\": 0, \"manifest_ns\": 0, \"checksum_ns\": 0, \"signature_ns\": 0, "
+              "\"abi_filter_ns\": 0, \"load_ns\": 0, \"total_ns\": 0, \"plugins\": []}\n");
+
+    stats.path = "dir/\"quoted\".fbundle";
+    stats.load = std::chrono::nanoseconds(42);
+    stats.plugins = {"a", "b"};
+    const std::string json = fourdst::plugin::bundle::to_json(stats);
+    EXPECT_NE(json.find("\"path\": \"dir/\\\"quoted\\\".fbundle\""), std::string::npos);
+    EXPECT_NE(json.find("\"load_ns\": 42"), std::string::npos);
+    EXPECT_NE(json.find("\"plugins\": [\"a\", \"b\"]}"), std::string::npos);
+}
+
+// --- R18: Call Latency Profiling ---
+
+TEST_F(PluginManagerTest, R18_1_HistogramPercentilesAreWithinBucketPrecision) {
+    using fourdst::plugin::profile::LatencyHistogram;
+    for (std::uint64_t ns : {0ull, 1ull, 63ull, 64ull, 65ull, 1000ull, 123'456ull, 9'999'999'999ull}) {
+        const std::size_t index = LatencyHistogram::bucket_index(ns);
+        EXPECT_GE(LatencyHistogram::bucket_upper_bound(index), ns);
+        EXPECT_LE(LatencyHistogram::bucket_upper_bound(index), ns + ns / LatencyHistogram::kSubBuckets);
+        if (index > 0) {
+            EXPECT_LT(LatencyHistogram::bucket_upper_bound(index - 1), ns);
+        }
+    }
+    EXPECT_EQ(LatencyHistogram::bucket_index(UINT64_MAX), LatencyHistogram::kBucketCount - 1);
+
+    LatencyHistogram histogram;
+    EXPECT_EQ(histogram.percentile(50).count(), 0);
+    for (int ns = 1; ns <= 1000; ++ns) {
+        histogram.record(std::chrono::nanoseconds(ns * 1000));
+    }
+    EXPECT_EQ(histogram.count(), 1000u);
+    EXPECT_EQ(histogram.min().count(), 1000);
+    EXPECT_EQ(histogram.max().count(), 1'000'000);
+    EXPECT_EQ(histogram.mean().count(), 500'500);
+    EXPECT_NEAR(histogram.percentile(50).count(), 500'000, 500'000 / 32);
+    EXPECT_NEAR(histogram.percentile(99).count(), 990'000, 990'000 / 32);
+    EXPECT_EQ(histogram.percentile(100).count(), 1'000'000);
+
+    LatencyHistogram other;
+    other.record(std::chrono::nanoseconds(5), 3);
+    histogram.merge(other);
+    EXPECT_EQ(histogram.count(), 1003u);
+    EXPECT_EQ(histogram.min().count(), 5);
+}
+
+TEST_F(PluginManagerTest, R18_2_ProfiledFunctorRecordsEveryForwardedCall) {
+    fourdst::plugin::manager::PluginManager tenant;
+    tenant.load(functor_plugin_path);
+    const auto* functor = tenant.get<IExampleFunctor>("FunctorPlugin");
+    fourdst::plugin::templates::ProfiledFunctor<ExampleContext> profiled(*functor);
+    EXPECT_STREQ(profiled.get_name(), "FunctorPlugin");
+
+    const fourdst::plugin::templates::FunctorPlugin_T<ExampleContext>& as_plugin = profiled;
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(as_plugin(ExampleContext{i, 0.0}).value, 2 * i);
+    }
+    const auto latency = profiled.latency();
+    EXPECT_EQ(latency.count(), 100u);
+    EXPECT_LE(latency.min(), latency.percentile(50));
+    EXPECT_LE(latency.percentile(50), latency.max());
+    EXPECT_NE(fourdst::plugin::profile::to_json(latency).find("\"count\": 100"), std::string::npos);
+
+    fourdst::plugin::templates::ProfiledFunctor<ExampleContext> sampled(*functor, 10);
+    for (int i = 0; i < 100; ++i) {
+        (void)sampled(ExampleContext{i, 0.0});
+    }
+    EXPECT_EQ(sampled.latency().count(), 10u);
+}
+
+TEST_F(PluginManagerTest, R18_3_MethodProfileTimesArbitraryInterfaceMethods) {
+    fourdst::plugin::manager::PluginManager tenant;
+    tenant.load(valid_plugin_path);
+    const auto* plugin = tenant.get<IValidPlugin>("ValidPlugin");
+
+    fourdst::plugin::profile::MethodProfile profile;
+    auto& magic = profile.method("get_magic_number");
+    EXPECT_EQ(&profile.method("get_magic_number"), &magic);
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_EQ(fourdst::plugin::profile::profiled_call(magic, &IValidPlugin::get_magic_number, plugin), 42);
+    }
+    (void)fourdst::plugin::profile::profiled_call(profile.method("get_name"), [&] { return plugin->get_name(); });
+
+    const auto histograms = profile.snapshot();
+    ASSERT_EQ(histograms.size(), 2u);
+    EXPECT_EQ(histograms.at("get_magic_number").count(), 5u);
+    EXPECT_EQ(histograms.at("get_name").count(), 1u);
+}
+
+// --- R19: Trace Export ---
+
+TEST_F(PluginManagerTest, R19_1_TraceRecordsLoadsUnloadsAndPluginCalls) {
+    const std::filesystem::path trace_path = std::filesystem::temp_directory_path() / "fourdst_r19_1.trace.json";
+    fourdst::plugin::profile::Tracer::start(trace_path);
+    EXPECT_TRUE(fourdst::plugin::profile::Tracer::enabled());
+    EXPECT_THROW(fourdst::plugin::profile::Tracer::start(trace_path), std::runtime_error);
+
+    {
+        fourdst::plugin::manager::PluginManager tenant;
+        tenant.load(functor_plugin_path);
+        fourdst::plugin::templates::ProfiledFunctor<ExampleContext> profiled(*tenant.get<IExampleFunctor>("FunctorPlugin"));
+        std::thread worker([&] { (void)profiled(ExampleContext{1, 0.0}); });
+        (void)profiled(ExampleContext{2, 0.0});
+        worker.join();
+        tenant.unload("FunctorPlugin");
+    }
+
+    const auto summary = fourdst::plugin::profile::Tracer::stop();
+    EXPECT_FALSE(fourdst::plugin::profile::Tracer::enabled());
+    EXPECT_EQ(summary.dropped, 0u);
+    EXPECT_GE(summary.written, 4u);
+    EXPECT_EQ(fourdst::plugin::profile::Tracer::stop().written, 0u);
+
+    std::ifstream in(trace_path);
+    const std::string trace((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    EXPECT_EQ(trace.rfind("{\"traceEvents\": [", 0), 0u);
+    EXPECT_NE(trace.find("\"name\": \"load\", \"cat\": \"manager\""), std::string::npos);
+    EXPECT_NE(trace.find("\"name\": \"unload\", \"cat\": \"manager\""), std::string::npos);
+    EXPECT_NE(trace.find("\"args\": {\"detail\": \"FunctorPlugin\"}"), std::string::npos);
+
+    std::size_t spans = 0;
+    for (std::size_t at = trace.find("\"ph\": \"X\""); at != std::string::npos; at = trace.find("\"ph\": \"X\"", at + 1)) {
+        ++spans;
+    }
+    EXPECT_EQ(spans, summary.written);
+    std::filesystem::remove(trace_path);
+}
+
+TEST_F(PluginManagerTest, R19_2_FullRingsDropSpansInsteadOfBlocking) {
+    const std::filesystem::path trace_path = std::filesystem::temp_directory_path() / "fourdst_r19_2.trace.json";
+    fourdst::plugin::profile::Tracer::start(trace_path, {.ring_capacity = 8, .flush_interval = std::chrono::hours(1)});
+    for (int i = 0; i < 100; ++i) {
+        fourdst::plugin::profile::TraceSpan span("test", "span");
+    }
+    const auto summary = fourdst::plugin::profile::Tracer::stop();
+    EXPECT_EQ(summary.written, 8u);
+    EXPECT_EQ(summary.dropped, 92u);
+
+    // Spans outside a trace are not recorded anywhere
+    fourdst::plugin::profile::TraceSpan ignored("test", "span");
+    std::filesystem::remove(trace_path);
+}
+
+// --- R20: Plugin Warm-up ---
+
+TEST_F(PluginManagerTest, R20_1_WarmupRunsInTheBackgroundAndWaitUntilWarmBlocks) {
+    fourdst::plugin::manager::PluginManager tenant;
+    EXPECT_TRUE(tenant.wait_until_warm(std::chrono::milliseconds(0)));
+
+    tenant.load(WARMUP_PLUGIN_PATH);
+    const auto* plugin = tenant.get<IExampleFunctor>("WarmupPlugin");
+    tenant.wait_until_warm();
+    const auto warmed = (*plugin)(ExampleContext{0, 0.0});
+    EXPECT_EQ(warmed.value, 1);
+    EXPECT_EQ(warmed.threshold, 1.0);
+    EXPECT_TRUE(tenant.warmup_failures().empty());
+
+    // A replacement is warmed before it is swapped in
+    tenant.reload("WarmupPlugin", WARMUP_PLUGIN_PATH);
+    EXPECT_EQ((*tenant.get<IExampleFunctor>("WarmupPlugin"))(ExampleContext{0, 0.0}).value, 1);
+
+    // Plugins without a warm-up are unaffected
+    tenant.load(functor_plugin_path);
+    EXPECT_TRUE(tenant.wait_until_warm(std::chrono::milliseconds(0)));
+}
+
+TEST_F(PluginManagerTest, R20_2_FailedWarmupIsReportedAndThePluginStaysLoaded) {
+    fourdst::plugin::manager::PluginManager tenant;
+    g_warmup_should_fail = true;
+    tenant.load(WARMUP_PLUGIN_PATH);
+    EXPECT_TRUE(tenant.wait_until_warm(std::chrono::seconds(10)));
+    g_warmup_should_fail = false;
+
+    const auto failures = tenant.warmup_failures();
+    ASSERT_EQ(failures.size(), 1u);
+    EXPECT_EQ(failures[0].plugin_name, "WarmupPlugin");
+    EXPECT_EQ(failures[0].message, "warm-up failed");
+    EXPECT_THROW(std::rethrow_exception(failures[0].error), std::runtime_error);
+    EXPECT_EQ((*tenant.get<IExampleFunctor>("WarmupPlugin"))(ExampleContext{0, 0.0}).value, 0);
+    EXPECT_TRUE(tenant.has("WarmupPlugin"));
+}
+
+// --- R21: Deferred Unload and Fast Shutdown ---
+
+TEST_F(PluginManagerTest, R21_1_DeferredUnloadClosesLibrariesOnTheReaper) {
+    const auto path = std::filesystem::temp_directory_path() / "deferred_synthetic.so";
+    std::filesystem::copy_file(SYNTHETIC_PLUGIN_PATH, path, std::filesystem::copy_options::overwrite_existing);
+
+    fourdst::plugin::manager::PluginManager tenant;
+    tenant.set_deferred_unload();
+    tenant.load(path);
+    tenant.load(valid_plugin_path);
+    g_destructor_called = false;
+    tenant.unload("ValidPlugin");
+    EXPECT_TRUE(g_destructor_called); // Instances are still destroyed by unload() itself
+
+    tenant.unload("deferred_synthetic");
+    tenant.flush_unloads();
+    EXPECT_FALSE(library_is_mapped(path));
+    std::filesystem::remove(path);
+}
+
+TEST_F(PluginManagerTest, R21_2_FastShutdownDestroysInstancesButLeavesLibrariesMapped) {
+    const auto path = std::filesystem::temp_directory_path() / "fast_shutdown_synthetic.so";
+    std::filesystem::copy_file(SYNTHETIC_PLUGIN_PATH, path, std::filesystem::copy_options::overwrite_existing);
+
+    fourdst::plugin::manager::PluginManager tenant;
+    tenant.load(path);
+    tenant.load(valid_plugin_path);
+    g_destructor_called = false;
+    tenant.fast_shutdown();
+    EXPECT_TRUE(g_destructor_called);
+    EXPECT_FALSE(tenant.has("ValidPlugin"));
+    EXPECT_FALSE(tenant.has("fast_shutdown_synthetic"));
+    EXPECT_TRUE(library_is_mapped(path));
+    std::filesystem::remove(path);
+}
+
+// --- R22: No-throw API ---
+
+TEST_F(PluginManagerTest, R22_1_TryGetReportsErrorCodesWithoutThrowing) {
+    using fourdst::plugin::exception::PluginErrorCode;
+    fourdst::plugin::manager::PluginManager tenant;
+    tenant.load(valid_plugin_path);
+
+    const auto plugin = tenant.try_get<IValidPlugin>("ValidPlugin");
+    ASSERT_TRUE(plugin.has_value());
+    EXPECT_EQ((*plugin)->get_magic_number(), 42);
+
+    const auto missing = tenant.try_get<IValidPlugin>("MissingPlugin");
+    ASSERT_FALSE(missing.has_value());
+    EXPECT_EQ(missing.error(), PluginErrorCode::NotLoaded);
+    EXPECT_EQ(fourdst::plugin::exception::message(missing.error(), "MissingPlugin"),
+              "MissingPlugin has not been loaded or does not exist (have you called manager.load()?)");
+
+    const auto mismatched = tenant.try_get<IOtherInterface>("ValidPlugin");
+    ASSERT_FALSE(mismatched.has_value());
+    EXPECT_EQ(mismatched.error(), PluginErrorCode::TypeMismatch);
+    EXPECT_EQ(fourdst::plugin::exception::to_string(mismatched.error()), "plugin type mismatch");
+
+    tenant.register_lazy(non_existent_path, "Broken");
+    EXPECT_EQ(tenant.try_get<IValidPlugin>("Broken").error(), PluginErrorCode::LoadFailed);
+}
+
+TEST_F(PluginManagerTest, R22_2_TryLoadAndTryUnloadReportErrorCodesWithoutThrowing) {
+    using fourdst::plugin::exception::PluginErrorCode;
+    fourdst::plugin::manager::PluginManager tenant;
+
+    const auto loaded = tenant.try_load(valid_plugin_path);
+    ASSERT_TRUE(loaded.has_value());
+    EXPECT_EQ(*loaded, "ValidPlugin");
+    EXPECT_EQ(tenant.try_load(valid_plugin_path).error(), PluginErrorCode::NameCollision);
+    EXPECT_EQ(fourdst::plugin::exception::message(PluginErrorCode::NameCollision, valid_plugin_path.string()),
+              "The plugin in '" + valid_plugin_path.string() + "' has the name of an already loaded plugin.");
+    EXPECT_EQ(tenant.try_load(non_existent_path).error(), PluginErrorCode::LoadFailed);
+    EXPECT_EQ(tenant.try_load(invalid_lib_path).error(), PluginErrorCode::LoadFailed);
+    EXPECT_EQ(tenant.try_load(no_factory_plugin_path).error(), PluginErrorCode::MissingSymbol);
+
+    EXPECT_TRUE(tenant.try_unload("ValidPlugin").has_value());
+    EXPECT_EQ(tenant.try_unload("ValidPlugin").error(), PluginErrorCode::NotLoaded);
+    EXPECT_FALSE(tenant.has("ValidPlugin"));
+}
+
+// --- R23: Exported Symbol Lookup ---
+
+TEST_F(PluginManagerTest, R23_1_GetSymbolResolvesAndCachesTypedSymbols) {
+    using fourdst::plugin::exception::PluginErrorCode;
+    fourdst::plugin::manager::PluginManager tenant;
+    tenant.load(functor_plugin_path);
+
+    auto* double_all = tenant.get_symbol<void(int*, std::size_t)>("FunctorPlugin", "functor_plugin_double_all");
+    ASSERT_NE(double_all, nullptr);
+    int values[] = {1, 2, 3};
+    double_all(values, 3);
+    EXPECT_EQ(values[2], 6);
+    EXPECT_EQ(tenant.get_symbol<void(int*, std::size_t)>("FunctorPlugin", "functor_plugin_double_all"), double_all);
+
+    EXPECT_THROW((void)tenant.get_symbol<void()>("FunctorPlugin", "no_such_symbol"), fourdst::plugin::exception::PluginSymbolError);
+    EXPECT_EQ(tenant.try_get_symbol<void()>("FunctorPlugin", "no_such_symbol").error(), PluginErrorCode::MissingSymbol);
+    EXPECT_THROW((void)tenant.get_symbol<void()>("MissingPlugin", "functor_plugin_double_all"), fourdst::plugin::exception::PluginNotLoadedError);
+    EXPECT_EQ(tenant.try_get_symbol<void()>("MissingPlugin", "functor_plugin_double_all").error(), PluginErrorCode::NotLoaded);
+
+    // The cache goes with the plugin, so a reloaded plugin resolves afresh
+    tenant.unload("FunctorPlugin");
+    EXPECT_EQ(tenant.try_get_symbol<void()>("FunctorPlugin", "functor_plugin_double_all").error(), PluginErrorCode::NotLoaded);
+    tenant.load(functor_plugin_path);
+    EXPECT_TRUE(tenant.try_get_symbol<void(int*, std::size_t)>("FunctorPlugin", "functor_plugin_double_all").has_value());
+}
+
+TEST_F(PluginManagerTest, R23_2_RequiredSymbolsAreResolvedAtLoadTime) {
+    fourdst::plugin::manager::PluginManager tenant;
+    fourdst::plugin::manager::LoadOptions options;
+    options.required_symbols = {"functor_plugin_double_all", "no_such_symbol"};
+    EXPECT_THROW(tenant.load(functor_plugin_path, options), fourdst::plugin::exception::PluginSymbolError);
+    EXPECT_FALSE(tenant.has("FunctorPlugin"));
+
+    options.required_symbols.pop_back();
+    tenant.load(functor_plugin_path, options);
+    EXPECT_TRUE(tenant.try_get_symbol<void(int*, std::size_t)>("FunctorPlugin", "functor_plugin_double_all").has_value());
+}
+
+// --- R24: Function Tables ---
+
+namespace {
+    struct UnknownTable {
+        static constexpr fourdst::plugin::interface_id_t table_id = fourdst::plugin::make_interface_id("fourdst.tests.UnknownTable/1");
+        void (*run)();
+    };
+
+    // A newer layout of ExampleFunctorTable than the plugin was built with
+    struct ExtendedFunctorTable {
+        static constexpr fourdst::plugin::interface_id_t table_id = ExampleFunctorTable::table_id;
+        ExampleContext (*apply)(const ExampleContext& input);
+        void (*apply_all)(ExampleContext* values, std::size_t count);
+        void (*reset)();
+    };
+}
+
+TEST_F(PluginManagerTest, R24_1_FunctionTablesAreCallableAlongsideTheInterface) {
+    using fourdst::plugin::exception::PluginErrorCode;
+    fourdst::plugin::manager::PluginManager tenant;
+    tenant.load(functor_plugin_path);
+
+    const auto& table = tenant.get_function_table<ExampleFunctorTable>("FunctorPlugin");
+    EXPECT_EQ(table.apply(ExampleContext{21, 0.0}).value, 42);
+    ExampleContext values[] = {{1, 0.0}, {2, 1.0}};
+    table.apply_all(values, 2);
+    EXPECT_EQ(values[1].value, 4);
+    EXPECT_EQ(values[1].threshold, 2.0);
+    EXPECT_EQ(&tenant.get_function_table<ExampleFunctorTable>("FunctorPlugin"), &table);
+
+    // The interface keeps working
+    EXPECT_EQ((*tenant.get<IExampleFunctor>("FunctorPlugin"))(ExampleContext{21, 0.0}).value, 42);
+
+    EXPECT_THROW((void)tenant.get_function_table<UnknownTable>("FunctorPlugin"), fourdst::plugin::exception::PluginSymbolError);
+    EXPECT_EQ(tenant.try_get_function_table<ExtendedFunctorTable>("FunctorPlugin").error(), PluginErrorCode::MissingSymbol);
+    EXPECT_EQ(tenant.try_get_function_table<ExampleFunctorTable>("MissingPlugin").error(), PluginErrorCode::NotLoaded);
+
+    tenant.load(valid_plugin_path);
+    EXPECT_EQ(tenant.try_get_function_table<ExampleFunctorTable>("ValidPlugin").error(), PluginErrorCode::MissingSymbol);
+}
+
+// --- R25: Batched Functor Calls ---
+
+TEST_F(PluginManagerTest, R25_1_ApplyProcessesBatchesWithDefaultAndOverriddenLoops) {
+    fourdst::plugin::manager::PluginManager tenant;
+    tenant.load(functor_plugin_path);
+    tenant.load(STATEFUL_PLUGIN_PATH);
+    const std::vector<ExampleContext> in = {{1, 0.0}, {2, 0.0}, {3, 0.0}};
+    std::vector<ExampleContext> out(in.size());
+
+    // FunctorPlugin overrides apply()
+    const auto* functor = tenant.get<IExampleFunctor>("FunctorPlugin");
+    functor->apply(in, out);
+    EXPECT_EQ(out[2].value, 6);
+    EXPECT_EQ(out[2].threshold, 1.0);
+
+    // StatefulPlugin keeps the default, which calls operator() per element, in order
+    const auto* stateful = tenant.get<IExampleFunctor>("StatefulPlugin");
+    stateful->apply(in, out);
+    EXPECT_EQ(out[2].value, 6);
+    EXPECT_EQ(out[2].threshold, 3.0);
+
+    // In place
+    std::vector<ExampleContext> values = in;
+    functor->apply(values, values);
+    EXPECT_EQ(values[0].value, 2);
+
+    std::vector<ExampleContext> short_out(2);
+    EXPECT_THROW(functor->apply(in, short_out), std::invalid_argument);
+    EXPECT_THROW(stateful->apply(in, short_out), std::invalid_argument);
+
+    fourdst::plugin::templates::ProfiledFunctor<ExampleContext> profiled(*functor);
+    profiled.apply(in, out);
+    EXPECT_EQ(out[0].value, 2);
+    EXPECT_EQ(profiled.batch_latency().count(), 1u);
+    EXPECT_EQ(profiled.latency().count(), 0u);
+}
+
+// --- R26: In-place and Consuming Functor Calls ---
+
+TEST_F(PluginManagerTest, R26_1_TransformAndConsumingCallsMatchTheScalarOperator) {
+    fourdst::plugin::manager::PluginManager tenant;
+    tenant.load(functor_plugin_path);
+    tenant.load(STATEFUL_PLUGIN_PATH);
+
+    // FunctorPlugin overrides transform(); the consuming operator goes through it
+    const auto* functor = tenant.get<IExampleFunctor>("FunctorPlugin");
+    ExampleContext value{3, 0.0};
+    functor->transform(value);
+    EXPECT_EQ(value.value, 6);
+    EXPECT_EQ(value.threshold, 1.0);
+    const ExampleContext consumed = (*functor)(ExampleContext{4, 0.0});
+    EXPECT_EQ(consumed.value, 8);
+
+    // StatefulPlugin keeps the defaults, which bridge to operator()(const T&)
+    const auto* stateful = tenant.get<IExampleFunctor>("StatefulPlugin");
+    ExampleContext stateful_value{5, 0.0};
+    stateful->transform(stateful_value);
+    EXPECT_EQ(stateful_value.value, 5);
+    EXPECT_EQ(stateful_value.threshold, 1.0);
+    const ExampleContext stateful_consumed = (*stateful)(ExampleContext{2, 0.0});
+    EXPECT_EQ(stateful_consumed.value, 7);
+    EXPECT_EQ(stateful_consumed.threshold, 2.0);
+
+    fourdst::plugin::templates::ProfiledFunctor<ExampleContext> profiled(*functor);
+    ExampleContext profiled_value{1, 0.0};
+    profiled.transform(profiled_value);
+    EXPECT_EQ(profiled(std::move(profiled_value)).value, 4);
+    EXPECT_EQ(profiled.latency().count(), 2u);
+}
+
+// --- R27: Pipelines ---
+
+TEST_F(PluginManagerTest, R27_1_PipelineChainsBypassesAndTimesStages) {
+    fourdst::plugin::manager::PluginManager tenant;
+    tenant.load(functor_plugin_path);
+    fourdst::plugin::pipeline::Pipeline<ExampleContext> pipeline;
+    pipeline.add(tenant, "FunctorPlugin").add(tenant, "FunctorPlugin");
+    ASSERT_EQ(pipeline.size(), 2u);
+
+    const ExampleContext input{3, 0.0};
+    EXPECT_EQ(pipeline.run(input).value, 12);
+    EXPECT_EQ(pipeline.run(ExampleContext{1, 0.0}).value, 4);
+
+    pipeline.set_bypassed(1);
+    EXPECT_TRUE(pipeline.bypassed(1));
+    EXPECT_EQ(pipeline.run(input).value, 6);
+    EXPECT_THROW(pipeline.set_bypassed(2), std::out_of_range);
+
+    const std::vector<ExampleContext> batch = {{1, 0.0}, {2, 0.0}};
+    const auto once = pipeline.run_batch(batch);
+    EXPECT_EQ(once[1].value, 4);
+    pipeline.set_bypassed(1, false);
+    const auto twice = pipeline.run_batch(batch);
+    EXPECT_EQ(twice[1].value, 8);
+    EXPECT_EQ(batch[1].value, 2);
+
+    const auto timings = pipeline.timings();
+    ASSERT_EQ(timings.size(), 2u);
+    EXPECT_EQ(timings[0].name, "FunctorPlugin");
+    EXPECT_EQ(timings[0].latency.count(), 3u);
+    EXPECT_EQ(timings[1].latency.count(), 2u);
+    EXPECT_EQ(timings[0].batch_latency.count(), 2u);
+    EXPECT_EQ(timings[1].batch_latency.count(), 1u);
+}
+
+TEST_F(PluginManagerTest, R27_2_PipelineRunsManyInputsConcurrently) {
+    fourdst::plugin::manager::PluginManager tenant;
+    tenant.load(functor_plugin_path);
+    fourdst::plugin::pipeline::Pipeline<ExampleContext> pipeline;
+    pipeline.add(tenant, "FunctorPlugin").add(tenant, "FunctorPlugin");
+
+    std::vector<ExampleContext> values(1000);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        values[i] = {static_cast<int>(i), 0.0};
+    }
+    fourdst::plugin::utils::ThreadPool pool(4);
+    const auto results = pipeline.run_all(std::move(values), pool);
+    ASSERT_EQ(results.size(), 1000u);
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        EXPECT_EQ(results[i].value, static_cast<int>(i) * 4);
+    }
+    EXPECT_EQ(pipeline.timings()[1].latency.count(), 1000u);
+}
+
+// --- R28: Streaming Pipelines ---
+
+namespace {
+    // A stateless stage that throws on one particular input
+    class FailingFunctor final : public IExampleFunctor {
+        FOURDST_DECLARE_CONCURRENCY(Pure);
+        FailingFunctor() : IExampleFunctor("Failing", "1.0.0") {}
+        ExampleContext operator()(const ExampleContext& input) const override {
+            if (input.value == 13) {
+                throw std::runtime_error("unlucky");
+            }
+            return input;
+        }
+    };
+}
+
+TEST_F(PluginManagerTest, R28_1_StreamingPipelineKeepsOrderAcrossReplicasUnderBackPressure) {
+    fourdst::plugin::manager::PluginManager tenant;
+    tenant.load(functor_plugin_path);
+    // Queues of two items force every stage to wait on its neighbours
+    fourdst::plugin::pipeline::StreamingPipeline<ExampleContext> stream({.queue_capacity = 2});
+    stream.add(tenant, "FunctorPlugin").add(tenant, "FunctorPlugin", 3).add(tenant, "FunctorPlugin", 2);
+    stream.start();
+    EXPECT_THROW(stream.add(tenant, "FunctorPlugin"), std::logic_error);
+
+    std::vector<ExampleContext> values(500);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        values[i] = {static_cast<int>(i), 0.0};
+    }
+    const auto results = stream.run(std::move(values));
+    ASSERT_EQ(results.size(), 500u);
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        ASSERT_EQ(results[i].value, static_cast<int>(i) * 8);
+        ASSERT_EQ(results[i].threshold, 3.0);
+    }
+    EXPECT_FALSE(stream.pop().has_value());
+    EXPECT_EQ(stream.timings()[1].latency.count(), 500u);
+}
+
+TEST_F(PluginManagerTest, R28_2_StreamingPipelineStopsAndRethrowsWhenAStageThrows) {
+    const FailingFunctor failing;
+    fourdst::plugin::pipeline::StreamingPipeline<ExampleContext> stream({.queue_capacity = 4});
+    stream.add(failing, 2);
+    std::vector<ExampleContext> values(100);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        values[i] = {static_cast<int>(i), 0.0};
+    }
+    EXPECT_THROW(stream.run(std::move(values)), std::runtime_error);
+    EXPECT_THROW(stream.pop(), std::runtime_error);
+}
+
+// --- R29: Concurrency Traits ---
+
+static_assert(fourdst::plugin::execution_mode(fourdst::plugin::Concurrency::Pure) == fourdst::plugin::ExecutionMode::Shared);
+static_assert(fourdst::plugin::execution_mode(fourdst::plugin::Concurrency::Reentrant) == fourdst::plugin::ExecutionMode::Shared);
+static_assert(fourdst::plugin::execution_mode(fourdst::plugin::Concurrency::PerThreadInstance) == fourdst::plugin::ExecutionMode::Replicated);
+static_assert(fourdst::plugin::execution_mode(fourdst::plugin::Concurrency::Serialized) == fourdst::plugin::ExecutionMode::Serialized);
+
+TEST_F(PluginManagerTest, R29_1_PluginsReportTheirDeclaredConcurrency) {
+    using fourdst::plugin::Concurrency;
+    fourdst::plugin::manager::PluginManager tenant;
+    tenant.load(functor_plugin_path);
+    tenant.load(STATEFUL_PLUGIN_PATH);
+    tenant.load(UNSYNCHRONIZED_PLUGIN_PATH);
+    tenant.load(valid_plugin_path);
+
+    const auto* functor = tenant.get<IExampleFunctor>("FunctorPlugin");
+    EXPECT_EQ(functor->concurrency(), Concurrency::Pure);
+    EXPECT_EQ(tenant.get<IExampleFunctor>("StatefulPlugin")->concurrency(), Concurrency::Reentrant);
+    EXPECT_EQ(tenant.get<IExampleFunctor>("UnsynchronizedPlugin")->concurrency(), Concurrency::PerThreadInstance);
+    // Nothing declared: no promise
+    EXPECT_EQ(tenant.get<IValidPlugin>("ValidPlugin")->concurrency(), Concurrency::Serialized);
+
+    const fourdst::plugin::templates::ProfiledFunctor<ExampleContext> profiled(*functor);
+    EXPECT_EQ(profiled.concurrency(), Concurrency::Pure);
+}
+
+TEST_F(PluginManagerTest, R29_2_PipelinesReplicateOrSerializeStagesByTrait) {
+    fourdst::plugin::manager::PluginManager tenant;
+    tenant.load(functor_plugin_path);
+    tenant.load(UNSYNCHRONIZED_PLUGIN_PATH);
+    const auto& unsynchronized = *tenant.get<IExampleFunctor>("UnsynchronizedPlugin");
+    const auto make_values = [] {
+        std::vector<ExampleContext> values(2000);
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            values[i] = {static_cast<int>(i), 0.0};
+        }
+        return values;
+    };
+    fourdst::plugin::utils::ThreadPool pool(4);
+
+    // Added by name: every chunk leases an instance of its own
+    fourdst::plugin::pipeline::Pipeline<ExampleContext> replicated;
+    replicated.add(tenant, "FunctorPlugin").add(tenant, "UnsynchronizedPlugin");
+    const auto results = replicated.run_all(make_values(), pool);
+    EXPECT_EQ(results[1999].value, 1999 * 4);
+    EXPECT_LE(results[1999].threshold, 2000.0);
+
+    // Added by reference: the shared instance is called one thread at a time
+    fourdst::plugin::pipeline::Pipeline<ExampleContext> serialized;
+    serialized.add(unsynchronized).add(unsynchronized);
+    EXPECT_EQ(serialized.run_all(make_values(), pool)[7].value, 28);
+
+    fourdst::plugin::pipeline::StreamingPipeline<ExampleContext> stream({.queue_capacity = 8});
+    stream.add(tenant, "FunctorPlugin", 2).add(tenant, "UnsynchronizedPlugin", 3);
+    const auto streamed = stream.run(make_values());
+    for (std::size_t i = 0; i < streamed.size(); ++i) {
+        ASSERT_EQ(streamed[i].value, static_cast<int>(i) * 4);
+    }
+
+    // The same plugin by name twice: the second stage leases an instance instead of sharing
+    fourdst::plugin::pipeline::StreamingPipeline<ExampleContext> reused;
+    reused.add(tenant, "UnsynchronizedPlugin").add(tenant, "UnsynchronizedPlugin");
+    EXPECT_EQ(reused.run(make_values())[1999].value, 1999 * 4);
+
+    fourdst::plugin::pipeline::StreamingPipeline<ExampleContext> rejected;
+    EXPECT_THROW(rejected.add(unsynchronized, 2), std::invalid_argument);
+    rejected.add(unsynchronized);
+    EXPECT_THROW(rejected.add(unsynchronized), std::invalid_argument);
+}
+
+TEST_F(PluginManagerTest, R29_3_PluginsWithoutInterfaceIndexAreNeverQueried) {
+    using fourdst::plugin::Concurrency;
+    fourdst::plugin::manager::PluginManager tenant;
+    tenant.load(LEGACY_PLUGIN_PATH);
+    const auto queries = tenant.get_symbol<int()>("LegacyPlugin", "legacy_plugin_queries");
+
+    // Resolved by dynamic_cast, reported Serialized, and neither virtual is called
+    EXPECT_EQ(tenant.get<IValidPlugin>("LegacyPlugin")->get_magic_number(), 9);
+    EXPECT_EQ(tenant.try_get<IValidPlugin>("LegacyPlugin").value()->get_magic_number(), 9);
+    EXPECT_EQ(tenant.find_all<IValidPlugin>().size(), 1);
+    EXPECT_EQ(tenant.create_instance<IValidPlugin>("LegacyPlugin")->get_magic_number(), 9);
+    EXPECT_EQ(tenant.get_local<IValidPlugin>("LegacyPlugin")->get_magic_number(), 9);
+    EXPECT_THROW((void)tenant.get<IOtherInterface>("LegacyPlugin"), fourdst::plugin::exception::PluginTypeError);
+    EXPECT_EQ(tenant.concurrency("LegacyPlugin"), Concurrency::Serialized);
+    EXPECT_EQ(queries(), 0);
+
+    EXPECT_THROW((void)tenant.concurrency("MissingPlugin"), fourdst::plugin::exception::PluginNotLoadedError);
+}